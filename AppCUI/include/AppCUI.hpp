@@ -2149,7 +2149,11 @@ namespace Utils
         ~IniObject();
 
         bool CreateFromString(string_view text);
-        bool CreateFromFile(const std::filesystem::path& fileName);
+        /**
+         * Loads an INI file. In zero-copy mode the file is mapped in memory and names and values are not copied
+         * (the file must not be modified by other processes while the object uses it).
+         */
+        bool CreateFromFile(const std::filesystem::path& fileName, bool zeroCopy = false);
         bool Save(const std::filesystem::path& fileName);
         bool Create();
         void Clear();
@@ -2309,6 +2313,39 @@ namespace OS
         void Close() override;
     };
 
+    class EXPORT MappedFile
+    {
+        const uint8* data;
+        uint64 size;
+
+      public:
+        MappedFile();
+        ~MappedFile();
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * Maps an existing (non empty) file in memory for read. Pages are loaded by the OS only when accessed, so
+         * large files are not copied into the process memory.
+         * @param[in] filePath is the full path to an existing file.
+         */
+        bool OpenRead(const std::filesystem::path& filePath);
+        void Close();
+
+        inline const uint8* GetData() const
+        {
+            return data;
+        }
+        inline uint64 GetSize() const
+        {
+            return size;
+        }
+        inline Utils::BufferView GetContent() const
+        {
+            return Utils::BufferView(data, (size_t) size);
+        }
+    };
+
     class EXPORT DateTime
     {
         uint32 year, month, day, hour, minute, second;
@@ -2489,6 +2526,22 @@ namespace Graphics
         void EXPORT Init(const ConstString& Title, uint64 maxValue = 0, Flags flags = Flags::None);
         bool EXPORT Update(uint64 value, const ConstString& content);
         bool EXPORT Update(uint64 value);
+
+        // progress of a task that runs on a worker thread (the methods are cheap and can be called for every item)
+        class EXPORT Task
+        {
+          public:
+            virtual void Update(uint64 value)                              = 0;
+            virtual void Update(uint64 value, const ConstString& content) = 0;
+            virtual bool IsCanceled() const                                = 0;
+        };
+        // runs the task on the application thread pool while the progress panel is updated (and ESC is checked)
+        // at a fixed rate. Returns false if the task was canceled.
+        bool EXPORT Run(
+              const ConstString& Title,
+              uint64 maxValue,
+              const std::function<void(Task& task)>& task,
+              Flags flags = Flags::None);
     }; // namespace ProgressStatus
 
     enum class WriteTextFlags : uint32
@@ -2793,14 +2846,20 @@ namespace Graphics
             img.height   = 0;
         }
         ~Image();
-        bool Load(const std::filesystem::path& imageFilePath);
+        /**
+         * Loads an image (PNG or BMP) from a file. If a scale method is provided, the image is reduced while it is
+         * decoded (every pixel is the average color of a square block), so that a large image never has to be kept
+         * in memory at its full resolution. Drawing the result with ImageScaleMethod::NoScale gives the same output
+         * as drawing the full image with the provided scale method.
+         */
+        bool Load(const std::filesystem::path& imageFilePath, ImageScaleMethod scale = ImageScaleMethod::NoScale);
         bool Create(uint32 width, uint32 height);
         bool Create(uint32 width, uint32 height, string_view image);
-        bool Create(const uint8* imageBuffer, uint32 size);
-        inline bool Create(Utils::BufferView buf)
+        bool Create(const uint8* imageBuffer, uint32 size, ImageScaleMethod scale = ImageScaleMethod::NoScale);
+        inline bool Create(Utils::BufferView buf, ImageScaleMethod scale = ImageScaleMethod::NoScale)
         {
             if (buf.GetLength() <= 0xFFFFFFFF)
-                return Create(buf.GetData(), (uint32) buf.GetLength());
+                return Create(buf.GetData(), (uint32) buf.GetLength(), scale);
             else
                 return false;
         }
@@ -2853,6 +2912,7 @@ namespace Graphics
     };
 
     class EXPORT Canvas;
+    class EXPORT TiledCanvas;
     class EXPORT Renderer
     {
       protected:
@@ -2944,6 +3004,7 @@ namespace Graphics
 
         // Canvas & Images
         bool DrawCanvas(int x, int y, const Canvas& canvas, const ColorPair overwriteColor = NoColorPair);
+        bool DrawCanvas(int x, int y, TiledCanvas& canvas, const ColorPair overwriteColor = NoColorPair);
 
         // Clear
         bool ClearWithSpecialChar(SpecialChars charID, ColorPair color);
@@ -3025,6 +3086,62 @@ namespace Graphics
         }
     };
 
+    // A drawing surface split in tiles that are allocated the first time something is drawn over them. The tiles that
+    // were never drawn are shown as the fill character, so surfaces far too large for a Canvas can be used.
+    class EXPORT TiledCanvas
+    {
+      public:
+        // fills a tile on demand (when it becomes visible); the canvas uses the coordinates of the entire surface
+        using TileRenderer = std::function<void(Canvas& tile)>;
+
+      private:
+        struct Tile
+        {
+            std::unique_ptr<Canvas> Cells;
+            uint64 LastUsed;
+            bool Generated; // created by the tile renderer and never drawn over --> it can be discarded
+        };
+        std::map<uint64, Tile> Tiles;
+        TileRenderer renderTile;
+        uint32 Width, Height, TileWidth, TileHeight;
+        uint32 GeneratedTiles;
+        uint64 Frame;
+        int FillCharacter;
+        ColorPair FillColor;
+
+        Canvas* GetTile(uint32 tileX, uint32 tileY, bool forWrite);
+        void DiscardGeneratedTiles();
+
+      public:
+        TiledCanvas();
+        bool Create(
+              uint32 width,
+              uint32 height,
+              int fillCharacter = ' ',
+              ColorPair color   = DefaultColorPair,
+              uint32 tileWidth  = 128,
+              uint32 tileHeight = 32);
+        // the callback is called once for every tile that intersects the area (clipped to that tile)
+        bool Draw(int x, int y, uint32 width, uint32 height, const std::function<void(Canvas& tile)>& draw);
+        void SetTileRenderer(TileRenderer renderer);
+        void Invalidate();
+
+        inline uint32 GetWidth() const
+        {
+            return this->Width;
+        }
+        inline uint32 GetHeight() const
+        {
+            return this->Height;
+        }
+        inline uint32 GetAllocatedTilesCount() const
+        {
+            return static_cast<uint32>(this->Tiles.size());
+        }
+
+        friend class Renderer;
+    };
+
 }; // namespace Graphics
 namespace Controls
 {
@@ -3054,6 +3171,7 @@ namespace Controls
         class EXPORT KeySelector;
         class EXPORT ColorPicker;
         class EXPORT CharacterTable;
+        class EXPORT HexView;
     }; // namespace Factory
 
     enum class Event : uint32
@@ -3086,6 +3204,11 @@ namespace Controls
 
     using ItemHandle                       = uint32;
     constexpr ItemHandle InvalidItemHandle = 0xFFFFFFFF;
+
+    // used to add items in bulk: fills the texts (UTF-8, one for each column) of the index-th item and returns false
+    // if there are no more items. The texts only have to be valid until the next call.
+    using ItemsGenerator = std::function<bool(uint32 index, vector<string_view>& texts)>;
+
     class EXPORT Control;
     class EXPORT Button;
     class EXPORT TextField;
@@ -3101,6 +3224,16 @@ namespace Controls
 
     using namespace Utils;
 
+    // the native type of the values kept by a ListView column (DateTime values are unix timestamps)
+    enum class ListViewColumnType : uint8
+    {
+        Text = 0,
+        Int64,
+        UInt64,
+        Double,
+        DateTime
+    };
+
     class EXPORT ListViewItem
     {
       private:
@@ -3149,6 +3282,20 @@ namespace Controls
         bool HighlightText(uint32 subItemIndex, uint32 offset, uint32 charactersCount);
         bool SetValues(std::initializer_list<ConstString> value);
         const Graphics::CharacterBuffer& GetText(uint32 subItemIndex) const;
+        // the text shown in the cell (for the cells of a typed column the value is formatted into 'text')
+        bool GetFormattedText(uint32 subItemIndex, Graphics::CharacterBuffer& text) const;
+        bool SetValue(uint32 subItemIndex, int64 value);
+        bool SetValue(uint32 subItemIndex, uint64 value);
+        bool SetValue(uint32 subItemIndex, double value);
+        inline bool SetValue(uint32 subItemIndex, int32 value)
+        {
+            return SetValue(subItemIndex, (int64) value);
+        }
+        inline bool SetValue(uint32 subItemIndex, uint32 value)
+        {
+            return SetValue(subItemIndex, (uint64) value);
+        }
+        int32 CompareWith(const ListViewItem& other, uint32 subItemIndex) const;
         bool SetXOffset(uint32 value);
         uint32 GetXOffset() const;
         bool SetColor(Graphics::ColorPair color);
@@ -3733,6 +3880,10 @@ namespace Controls
         void SetVScrollBarTopMargin(uint32 space);
         void SetHScrollBarLeftMarging(uint32 space);
 
+        // frame updates - OnFrameUpdate is called only for the controls that enable them (a frame is ~33 ms)
+        void EnableFrameUpdates(uint32 framesInterval = 1);
+        void DisableFrameUpdates();
+
         // handlers
         virtual Handlers::Control* Handlers();
 
@@ -4087,6 +4238,24 @@ namespace Controls
         void SetTabCharacter(char tabCharacter);
         virtual ~TextArea();
 
+        /**
+         * Shows the content of an UTF-8 file in read-only mode. The file is mapped in memory and its lines are indexed
+         * in a background thread (the first lines are available right away), so only the visible lines are decoded
+         * and the memory used depends on the number of lines, not on the size of the file.
+         * @param[in] filePath is the full path to an existing (non empty) file.
+         */
+        bool OpenFile(const std::filesystem::path& filePath);
+        void CloseFile();
+        bool IsIndexingFile() const;
+        uint32 GetIndexingProgress() const; // percentage of the file that was indexed
+        /**
+         * Follows the file opened with OpenFile (like 'tail -f'): the bytes that are appended to it are indexed in
+         * background and the new lines are added in batches. The view scrolls automatically only if the last line
+         * is the current one.
+         */
+        bool SetFollowMode(bool enabled);
+        bool OnFrameUpdate() override;
+
         // handlers covariant
         Handlers::TextControl* Handlers() override;
 
@@ -4163,7 +4332,8 @@ namespace Controls
         /* 0 -> 0x40 (GATTR) */
         None          = 0x000000,
         Border        = 0x000100,
-        HideScrollBar = 0x000200
+        HideScrollBar = 0x000200,
+        Tiled         = 0x000400
     };
     class EXPORT CanvasViewer : public Control
     {
@@ -4174,6 +4344,13 @@ namespace Controls
               uint32 canvasWidth,
               uint32 canvasHeight,
               ViewerFlags flags);
+        CanvasViewer(
+              void* context,
+              const ConstString& caption,
+              string_view layout,
+              uint32 canvasWidth,
+              uint32 canvasHeight,
+              ViewerFlags flags);
 
       public:
         ~CanvasViewer();
@@ -4187,6 +4364,7 @@ namespace Controls
         void OnMouseReleased(int x, int y, Input::MouseButton button, Input::Key keyCode) override;
         void OnUpdateScrollBars() override;
         Reference<Graphics::Canvas> GetCanvas();
+        Reference<Graphics::TiledCanvas> GetTiledCanvas();
 
         friend Factory::CanvasViewer;
         friend Control;
@@ -4197,8 +4375,14 @@ namespace Controls
         ImageView(const ConstString& caption, string_view layout, ViewerFlags flags);
 
       public:
+        ~ImageView();
         bool SetImage(
               const Graphics::Image& img, Graphics::ImageRenderingMethod method, Graphics::ImageScaleMethod scale);
+        // loads the image already scaled (the full resolution image is never kept in memory)
+        bool SetImage(
+              const std::filesystem::path& imageFilePath,
+              Graphics::ImageRenderingMethod method,
+              Graphics::ImageScaleMethod scale);
 
         friend Factory::ImageView;
         friend Control;
@@ -4288,6 +4472,7 @@ namespace Controls
         void DeleteColumn(uint32 columnIndex);
         void SetFrozenColumnsCount(uint32 count = 0);
         std::optional<uint32> GetSortColumnIndex() const;
+        SortDirection GetSortDirection() const;
         Column GetSortColumn();
 
         void SetClipboardFormat(CopyClipboardFormat format, CopyClipboardFlags flags);
@@ -4320,7 +4505,8 @@ namespace Controls
         HideSearchBar                 = 0x010000,
         HideBorder                    = 0x020000,
         HideScrollBar                 = 0x040000,
-        PopupSearchBar                = 0x080000
+        PopupSearchBar                = 0x080000,
+        SearchIndex                   = 0x100000 // items are indexed (more memory) for faster searches in large lists
     };
 
     class EXPORT ListView : public ColumnsHeaderView
@@ -4347,6 +4533,21 @@ namespace Controls
         ListViewItem AddItem(const ConstString& text);
         ListViewItem AddItem(std::initializer_list<ConstString> values);
         void AddItems(std::initializer_list<std::initializer_list<ConstString>> items);
+        uint32 AddItems(uint32 count, const ItemsGenerator& getItem);
+        template <typename Rows>
+        inline uint32 AddItems(const Rows& rows)
+        {
+            auto row = std::begin(rows);
+            return AddItems(
+                  static_cast<uint32>(std::size(rows)),
+                  [&row](uint32, vector<string_view>& texts)
+                  {
+                      for (const auto& text : *row)
+                          texts.emplace_back(text);
+                      ++row;
+                      return true;
+                  });
+        }
         ListViewItem GetItem(uint32 index);
         ListViewItem GetCurrentItem();
         void SelectAllItems();
@@ -4359,6 +4560,12 @@ namespace Controls
         bool SetCurrentItem(ListViewItem item);
         void SetSearchString(const ConstString& text);
 
+        // typed columns keep the raw values and format only the cells that are painted
+        bool SetColumnType(
+              uint32 columnIndex,
+              ListViewColumnType type,
+              NumericFormat format = NumericFormat(NumericFormatFlags::None));
+
         // sort
         bool Sort();
         bool Sort(uint32 columnIndex, SortDirection direction);
@@ -4428,6 +4635,20 @@ namespace Controls
             return AddItem(caption, GenericRef(nullptr));
         }
 
+        uint32 AddItems(uint32 count, const ItemsGenerator& getItem);
+        template <typename Captions>
+        inline uint32 AddItems(const Captions& captions)
+        {
+            auto caption = std::begin(captions);
+            return AddItems(
+                  static_cast<uint32>(std::size(captions)),
+                  [&caption](uint32, vector<string_view>& texts)
+                  {
+                      texts.emplace_back(*caption);
+                      ++caption;
+                      return true;
+                  });
+        }
         bool AddSeparator(const ConstString& caption = "");
         void DeleteAllItems();
 
@@ -4535,7 +4756,7 @@ namespace Controls
         Searchable                      = 0x004000, // shows all elements highlighting the ones matching
         FilterSearch                    = 0x008000, // filters elements from view
         HideSearchBar                   = 0x010000, // disables FilterMode & SearchMode
-        // Reserved_020000                 = 0x020000,
+        SearchIndex                     = 0x020000, // items are indexed (more memory) for faster searches
         // Reserved_040000                 = 0x040000,
         // Reserved_080000                 = 0x080000,
         // Reserved_100000                 = 0x100000,
@@ -4544,6 +4765,21 @@ namespace Controls
         // Reserved_800000                 = 0x800000
     };
 
+    // lazy children (TreeViewItem::SetChildrenLoader): the loader runs on a worker thread and sends every child
+    // through 'addChild' (its UTF-8 texts, one for each column, and a loader for its own children if it is
+    // expandable). 'addChild' returns false once the item was folded --> the loader should stop at that point.
+    class TreeViewChildrenReceiver;
+    using TreeViewChildrenLoader = std::function<void(TreeViewChildrenReceiver& addChild)>;
+    class TreeViewChildrenReceiver
+    {
+      public:
+        virtual bool operator()(const vector<string_view>& texts, TreeViewChildrenLoader childrenLoader) = 0;
+        inline bool operator()(const vector<string_view>& texts)
+        {
+            return (*this)(texts, nullptr);
+        }
+    };
+
     class EXPORT TreeViewItem
     {
       private:
@@ -4582,6 +4818,21 @@ namespace Controls
         }
 
         TreeViewItem AddChild(ConstString name, bool isExpandable = false);
+        uint32 AddChildren(uint32 count, const ItemsGenerator& getItem);
+        template <typename Rows>
+        inline uint32 AddChildren(const Rows& rows)
+        {
+            auto row = std::begin(rows);
+            return AddChildren(
+                  static_cast<uint32>(std::size(rows)),
+                  [&row](uint32, vector<string_view>& texts)
+                  {
+                      for (const auto& text : *row)
+                          texts.emplace_back(text);
+                      ++row;
+                      return true;
+                  });
+        }
         bool SetText(ConstString name);
         const AppCUI::Graphics::CharacterBuffer& GetText() const;
         bool SetValues(const std::initializer_list<ConstString> values);
@@ -4611,6 +4862,8 @@ namespace Controls
         TreeViewItem GetParent() const;
         uint32 GetPriority() const;
         bool SetPriority(uint32 priority) const;
+        bool SetChildrenLoader(TreeViewChildrenLoader loader);
+        bool IsLoadingChildren() const;
 
         template <typename T>
         constexpr inline bool SetData(Reference<T> obj)
@@ -4645,6 +4898,8 @@ namespace Controls
               TreeViewFlags flags = TreeViewFlags::None);
 
       public:
+        ~TreeView();
+
         void Paint(Graphics::Renderer& renderer) override;
         bool OnKeyEvent(Input::Key keyCode, char16 UnicodeChar) override;
         void OnFocus() override;
@@ -4653,6 +4908,7 @@ namespace Controls
         bool OnMouseOver(int x, int y) override;
         void OnUpdateScrollBars() override;
         void OnAfterResize(int newWidth, int newHeight) override;
+        bool OnFrameUpdate() override;
 
         // columns header view
         void OnColumnClicked(uint32 columnIndex) override;
@@ -4670,6 +4926,21 @@ namespace Controls
         uint32 GetItemsCount() const;
         TreeViewItem GetItemByHandle(ItemHandle handle);
         TreeViewItem AddItem(ConstString name, bool isExpandable = false);
+        uint32 AddItems(uint32 count, const ItemsGenerator& getItem);
+        template <typename Rows>
+        inline uint32 AddItems(const Rows& rows)
+        {
+            auto row = std::begin(rows);
+            return AddItems(
+                  static_cast<uint32>(std::size(rows)),
+                  [&row](uint32, vector<string_view>& texts)
+                  {
+                      for (const auto& text : *row)
+                          texts.emplace_back(text);
+                      ++row;
+                      return true;
+                  });
+        }
 
         bool Sort();
         bool Sort(uint32 columnIndex, SortDirection direction);
@@ -4744,6 +5015,14 @@ namespace Controls
         std::optional<std::string> GetSelectedCellContent();
         std::optional<std::pair<std::string, std::vector<std::string>>> GetSelectedColumnContent();
 
+        // cells (row * columns + column) with the same content as the given cell - empty cells are never duplicates
+        std::vector<uint32> FindEqualCells(uint32 index) const;
+        uint32 GetDuplicatedCellsCount() const;
+
+        // UTF-8 CSV files (use '\t' as separator for TSV files) - the first row can be used as the header
+        bool ImportCSV(const std::filesystem::path& path, char separator = ',', bool hasHeader = true);
+        bool ExportCSV(const std::filesystem::path& path, char separator = ',', bool addHeader = true) const;
+
       private:
         friend Factory::Grid;
         friend Control;
@@ -4862,6 +5141,55 @@ namespace Controls
         friend Factory::CharacterTable;
         friend Control;
     };
+    class EXPORT HexView : public Control
+    {
+      protected:
+        HexView(string_view layout);
+
+      public:
+        virtual ~HexView();
+
+        /**
+         * Shows the content of a file. The file is mapped in memory (the OS loads only the pages that are displayed
+         * or searched), so files of any size can be viewed.
+         * @param[in] filePath is the full path to an existing (non empty) file.
+         */
+        bool OpenFile(const std::filesystem::path& filePath);
+        /**
+         * Shows the content of a data object. Only the visible bytes (and the ones that are searched) are read.
+         * @param[in] dataObject is the object to be displayed (the control becomes its owner).
+         */
+        bool Open(std::unique_ptr<OS::DataObject> dataObject);
+        void Close();
+
+        uint64 GetSize() const;
+        uint64 GetCursorOffset() const;
+        bool GoTo(uint64 offset);
+
+        /**
+         * Searches for a sequence of bytes in a background thread (a previous search is stopped). The matches that
+         * were already found are highlighted while the search continues.
+         * @param[in] pattern the bytes to look for (the content is copied).
+         */
+        bool Search(Utils::BufferView pattern);
+        void StopSearch();
+        bool IsSearching() const;
+        uint64 GetSearchedBytes() const;
+        uint64 GetSearchResultsCount() const;
+        bool GoToNextSearchResult();
+        bool GoToPreviousSearchResult();
+
+        void Paint(Graphics::Renderer& renderer) override;
+        bool OnKeyEvent(Input::Key keyCode, char16 UnicodeChar) override;
+        void OnMousePressed(int x, int y, Input::MouseButton button, Input::Key keyCode) override;
+        bool OnMouseWheel(int x, int y, Input::MouseWheel direction, Input::Key keyCode) override;
+        bool OnFrameUpdate() override;
+        void OnAfterResize(int newWidth, int newHeight) override;
+        void OnUpdateScrollBars() override;
+
+        friend Factory::HexView;
+        friend Control;
+    };
 
     namespace Factory
     {
@@ -5286,6 +5614,15 @@ namespace Controls
             static Reference<Controls::CharacterTable> Create(Controls::Control& parent, string_view layout);
             static Pointer<Controls::CharacterTable> Create(string_view layout);
         };
+        class EXPORT HexView
+        {
+            HexView() = delete;
+
+          public:
+            static Reference<Controls::HexView> Create(Controls::Control* parent, string_view layout);
+            static Reference<Controls::HexView> Create(Controls::Control& parent, string_view layout);
+            static Pointer<Controls::HexView> Create(string_view layout);
+        };
     } // namespace Factory
 
 }; // namespace Controls
@@ -5564,6 +5901,8 @@ namespace Application
           int controlID);
     EXPORT Utils::Reference<Controls::Desktop> GetDesktop();
     EXPORT void Close();
+    // executed by the application thread pool - tasks that may block (slow I/O, network) do not delay the others
+    EXPORT bool RunInBackground(std::function<void()> task, bool mayBlock = false);
     EXPORT void SetTheme(ThemeType themeType);
     EXPORT bool SetSpecialCharacterSet(SpecialCharacterSetType characterSetType);
 }; // namespace Application
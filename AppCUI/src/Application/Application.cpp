@@ -119,6 +119,11 @@ void Application::Close()
     if (app)
         app->Terminate();
 }
+bool Application::RunInBackground(std::function<void()> task, bool mayBlock)
+{
+    CHECK(app, false, "Application has not been initialized !");
+    return app->Workers.Run(std::move(task), mayBlock);
+}
 ItemHandle Application::AddWindow(unique_ptr<Window> wnd, ItemHandle referal)
 {
     CHECK(app, InvalidItemHandle, "Application has not been initialized !");
@@ -299,6 +304,63 @@ void UpdateCommandBar()
     app->cmdBar->OnMouseMove(app->LastMouseX, app->LastMouseY, repaint);
     app->cmdBarUpdate = false;
 }
+// checks if at least one character of a clip is not covered by the occluding controls
+bool IsPartiallyVisible(const Graphics::Clip& clip)
+{
+    const auto left   = clip.ClipRect.X;
+    const auto top    = clip.ClipRect.Y;
+    const auto right  = clip.ClipRect.X + clip.ClipRect.Width;
+    const auto bottom = clip.ClipRect.Y + clip.ClipRect.Height;
+    auto& candidates  = app->OccludersInClip;
+    candidates.clear();
+    for (const auto& o : app->Occluders)
+    {
+        if ((o.Left >= right) || (o.Right <= left) || (o.Top >= bottom) || (o.Bottom <= top))
+            continue;
+        if ((o.Left <= left) && (o.Right >= right) && (o.Top <= top) && (o.Bottom >= bottom))
+            return false; // one control covers the entire clip
+        candidates.push_back(o);
+    }
+    if (candidates.empty())
+        return true;
+
+    for (auto y = top; y < bottom; y++)
+    {
+        // jump over the occluding controls until the first visible character on this line
+        auto x = left;
+        for (auto moved = true; moved && (x < right);)
+        {
+            moved = false;
+            for (const auto& o : candidates)
+            {
+                if ((y >= o.Top) && (y < o.Bottom) && (x >= o.Left) && (x < o.Right))
+                {
+                    x     = o.Right;
+                    moved = true;
+                }
+            }
+        }
+        if (x < right)
+            return true;
+    }
+    return false;
+}
+void AddOccludingControl(Controls::Control* ctrl)
+{
+    auto Members = (ControlContext*) ctrl->Context;
+    if ((Members->Flags & (GATTR_VISIBLE | GATTR_OPAQUE)) != (GATTR_VISIBLE | GATTR_OPAQUE))
+        return;
+    if ((!Members->ScreenClip.Visible) || (ctrl == app->ExpandedControl))
+        return;
+    const auto& r = Members->ScreenClip.ClipRect;
+    app->Occluders.push_back({ ctrl, r.X, r.Y, r.X + r.Width, r.Y + r.Height });
+}
+// a control does not cover itself (occluders are removed in paint order, so it can only be the last one)
+void RemoveOccludingControl(Controls::Control* ctrl)
+{
+    if ((!app->Occluders.empty()) && (app->Occluders.back().Owner == ctrl))
+        app->Occluders.pop_back();
+}
 void PaintControl(Controls::Control* ctrl, Graphics::Renderer& renderer, bool focused)
 {
     CHECKRET(ctrl != nullptr, "");
@@ -306,6 +368,12 @@ void PaintControl(Controls::Control* ctrl, Graphics::Renderer& renderer, bool fo
     if (((Members->Flags & GATTR_VISIBLE) == 0) || (!Members->ScreenClip.Visible))
         return;
 
+    // a control (with all of its children) that is covered by the opaque controls painted after it is skipped
+    // (unless its focus state has to change)
+    if ((Members->Started) && (!focused) && (!Members->Focused) && (ctrl != app->ExpandedControl) &&
+        (!IsPartiallyVisible(Members->ScreenClip)))
+        return;
+
     // check if started
     if (!Members->Started)
     {
@@ -344,6 +412,19 @@ void PaintControl(Controls::Control* ctrl, Graphics::Renderer& renderer, bool fo
                 app->PackControl(false);
         }
     }
+    const auto cnt = Members->ControlsCount;
+    const auto idx = Members->CurrentControlIndex;
+    // children are painted in this order (the focused one is the last one)
+    auto getChild = [Members, cnt, idx](uint32 order) {
+        return Members->Controls[idx >= cnt ? order : (order + idx + 1) % cnt];
+    };
+
+    // opaque children also cover their parent (they are added in reverse order --> the next one painted is last)
+    const auto occludersCount = app->Occluders.size();
+    for (auto order = cnt; order > 0; order--)
+        AddOccludingControl(getChild(order - 1));
+    auto paintCurrentControl = true;
+
     // put the other clip
     if (ctrl == app->ExpandedControl)
     {
@@ -351,9 +432,19 @@ void PaintControl(Controls::Control* ctrl, Graphics::Renderer& renderer, bool fo
         app->terminal->screenCanvas.SetTranslate(
               Members->ExpandedViewClip.ScreenPosition.X, Members->ExpandedViewClip.ScreenPosition.Y);
     }
+    else if (app->Occluders.size() > 0)
+    {
+        // a control that is entirely covered by its opaque children is not painted
+        // (the clip is not reduced to the visible part as SetClipMargins/SetClipRect are relative to it)
+        paintCurrentControl = IsPartiallyVisible(Members->ScreenClip);
+    }
 
     // draw current control
-    if (Members->handlers)
+    if (!paintCurrentControl)
+    {
+        // nothing to draw
+    }
+    else if (Members->handlers)
     {
         if (Members->handlers->PaintControl.obj)
         {
@@ -385,28 +476,14 @@ void PaintControl(Controls::Control* ctrl, Graphics::Renderer& renderer, bool fo
     renderer.DrawRectSize(0, 0, ctrl->GetWidth(), ctrl->GetHeight(), { Color::White, Color::Transparent }, false);
 #endif
 
-    const auto cnt = Members->ControlsCount;
-    const auto idx = Members->CurrentControlIndex;
-
-    if (idx >= cnt)
+    // if one control is selected, it is painted last and it is the only one that can be focused
+    for (uint32 order = 0; order < cnt; order++)
     {
-        // no selected control ==> draw all of them
-        for (uint32 tr = 0; tr < cnt; tr++)
-        {
-            PaintControl(Members->Controls[tr], renderer, false);
-        }
-    }
-    else
-    {
-        // one control is selected (paint controls that are not focused)
-        for (uint32 tr = 1; tr < cnt; tr++)
-        {
-            PaintControl(Members->Controls[(tr + idx) % cnt], renderer, false);
-        }
-
-        // paint focused control
-        PaintControl(Members->Controls[idx], renderer, focused);
+        auto child = getChild(order);
+        RemoveOccludingControl(child);
+        PaintControl(child, renderer, (idx < cnt) && (order + 1 == cnt) ? focused : false);
     }
+    app->Occluders.resize(occludersCount);
 }
 void PaintMenu(Controls::Menu* menu, Graphics::Renderer& renderer, bool activ)
 {
@@ -424,11 +501,23 @@ void PaintMenu(Controls::Menu* menu, Graphics::Renderer& renderer, bool activ)
           menuContext->ScreenClip.ScreenPosition.X, menuContext->ScreenClip.ScreenPosition.Y);
     menuContext->Paint(renderer, activ);
 }
+bool IsSameClip(const Graphics::Clip& c1, const Graphics::Clip& c2)
+{
+    return (c1.Visible == c2.Visible) && (c1.ScreenPosition.X == c2.ScreenPosition.X) &&
+           (c1.ScreenPosition.Y == c2.ScreenPosition.Y) && (c1.ClipRect.X == c2.ClipRect.X) &&
+           (c1.ClipRect.Y == c2.ClipRect.Y) && (c1.ClipRect.Width == c2.ClipRect.Width) &&
+           (c1.ClipRect.Height == c2.ClipRect.Height);
+}
 void ComputeControlLayout(Graphics::Clip& parentClip, Control* ctrl)
 {
     if (ctrl == nullptr)
         return;
     CREATE_CONTROL_CONTEXT(ctrl, Members, );
+    // same parent clip and no layout change in this branch --> clips computed last time are still valid
+    if ((!Members->ScreenClipOutdated) && (IsSameClip(parentClip, Members->ParentClip)))
+        return;
+    Members->ParentClip         = parentClip;
+    Members->ScreenClipOutdated = false;
     // compute the clip
     Members->ScreenClip.Set(
           parentClip, Members->Layout.X, Members->Layout.Y, Members->Layout.Width, Members->Layout.Height);
@@ -469,24 +558,6 @@ void DestroyControl(Controls::Control* ctrl)
     }
     delete ctrl;
 }
-bool ProcessUpdateFrameEvent(Controls::Control* ctrl)
-{
-    CREATE_CONTROL_CONTEXT(ctrl, Members, false);
-    if ((Members->Flags & (GATTR_VISIBLE | GATTR_ENABLE)) != (GATTR_VISIBLE | GATTR_ENABLE))
-        return false; // no need to call the function
-    bool res = ctrl->OnFrameUpdate();
-    if (Members->ControlsCount > 0)
-    {
-        auto s = Members->Controls;
-        auto e = s + Members->ControlsCount;
-        while (s < e)
-        {
-            res |= ProcessUpdateFrameEvent(*s);
-            s++;
-        }
-    }
-    return res;
-}
 Controls::Control* RecursiveCoordinatesToControl(Controls::Control* ctrl, int x, int y)
 {
     if (ctrl == nullptr)
@@ -809,10 +880,18 @@ void ApplicationImpl::Paint()
 
     if (ModalControlsCount > 0)
     {
+        // modal windows cover the desktop and the modal windows below them
+        this->Occluders.clear();
+        for (auto tr = ModalControlsCount; tr > 0; tr--)
+            AddOccludingControl(ModalControlsStack[tr - 1]);
         PaintControl(this->AppDesktop, this->terminal->screenCanvas, false);
         uint32 tmp = ModalControlsCount - 1;
         for (uint32 tr = 0; tr < tmp; tr++)
+        {
+            RemoveOccludingControl(ModalControlsStack[tr]);
             PaintControl(ModalControlsStack[tr], this->terminal->screenCanvas, false);
+        }
+        this->Occluders.clear();
         this->terminal->screenCanvas.DarkenScreen();
         PaintControl(ModalControlsStack[ModalControlsCount - 1], this->terminal->screenCanvas, true);
     }
@@ -1179,6 +1258,7 @@ bool ApplicationImpl::ExpandControl(Controls::Control* ctrl)
     this->ExpandedControl = ctrl;
     // remove GATTR_EXPANDED flag if exists
     Members->Flags -= (Members->Flags & GATTR_EXPANDED);
+    Members->InvalidateScreenClip();
     // compute current positions
     ComputePositions();
     this->ToolTip.Hide();
@@ -1291,14 +1371,8 @@ bool ApplicationImpl::ExecuteEventLoop(Control* ctrl, bool resetState)
             RepaintStatus = REPAINT_STATUS_NONE;
         }
         this->terminal->GetSystemEvent(evnt);
-        if (evnt.updateFrames)
-        {
-            if (ProcessUpdateFrameEvent(this->AppDesktop))
-                this->RepaintStatus |= REPAINT_STATUS_DRAW;
-            for (uint32 tr = 0; tr < ModalControlsCount; tr++)
-                if (ProcessUpdateFrameEvent(this->ModalControlsStack[tr]))
-                    this->RepaintStatus |= REPAINT_STATUS_DRAW;
-        }
+        if ((evnt.updateFrames) && (FrameUpdates.Tick()))
+            this->RepaintStatus |= REPAINT_STATUS_DRAW;
         switch (evnt.eventType)
         {
         case SystemEventType::AppClosed:
@@ -0,0 +1,83 @@
+#include "ControlContext.hpp"
+
+namespace AppCUI::Internal
+{
+bool IsControlActive(Controls::Control* ctrl)
+{
+    // hidden or disabled controls (or controls placed in a hidden/disabled parent) are not updated
+    while (ctrl)
+    {
+        auto Members = reinterpret_cast<ControlContext*>(ctrl->Context);
+        if ((!Members) || ((Members->Flags & (GATTR_VISIBLE | GATTR_ENABLE)) != (GATTR_VISIBLE | GATTR_ENABLE)))
+            return false;
+        ctrl = Members->Parent;
+    }
+    return true;
+}
+
+FrameUpdateScheduler::FrameUpdateScheduler() : CurrentSlot(0)
+{
+}
+void FrameUpdateScheduler::Schedule(Controls::Control* control, uint32 interval)
+{
+    const auto slot = (CurrentSlot + interval) % SLOTS_COUNT;
+    Slots[slot].push_back({ control, interval, (interval - 1) / SLOTS_COUNT });
+    Subscribed[control] = slot;
+}
+void FrameUpdateScheduler::Subscribe(Controls::Control* control, uint32 interval)
+{
+    Unsubscribe(control); // a new interval replaces the previous one
+    Schedule(control, std::max<>(interval, 1U));
+}
+void FrameUpdateScheduler::Unsubscribe(Controls::Control* control)
+{
+    auto it = Subscribed.find(control);
+    if (it == Subscribed.end())
+        return;
+    auto& slot = Slots[it->second];
+    for (auto s = slot.begin(); s != slot.end(); s++)
+    {
+        if (s->Control == control)
+        {
+            slot.erase(s);
+            break;
+        }
+    }
+    Subscribed.erase(it);
+}
+bool FrameUpdateScheduler::Tick()
+{
+    if (Subscribed.empty())
+        return false;
+    CurrentSlot = (CurrentSlot + 1) % SLOTS_COUNT;
+    auto& slot  = Slots[CurrentSlot];
+    if (slot.empty())
+        return false;
+    // subscribers with longer intervals stay in the slot for another turn of the wheel
+    vector<Subscriber> due;
+    size_t kept = 0;
+    for (auto& s : slot)
+    {
+        if (s.Rounds > 0)
+        {
+            s.Rounds--;
+            slot[kept++] = s;
+        }
+        else
+            due.push_back(s);
+    }
+    slot.resize(kept);
+    // everything is rescheduled before the callbacks run (they can subscribe or unsubscribe controls)
+    for (const auto& s : due)
+        Schedule(s.Control, s.Interval);
+    bool repaint = false;
+    for (const auto& s : due)
+    {
+        if (!Subscribed.contains(s.Control))
+            continue; // unsubscribed (or destroyed) by one of the previous callbacks
+        if (IsControlActive(s.Control))
+            repaint |= s.Control->OnFrameUpdate();
+    }
+    return repaint;
+}
+} // namespace AppCUI::Internal
@@ -0,0 +1,114 @@
+#include "Internal.hpp"
+
+namespace AppCUI::Internal
+{
+WorkerThreadPool::WorkerThreadPool() : state(std::make_shared<State>())
+{
+    state->Threads        = 0;
+    state->IdleThreads    = 0;
+    state->BlockingTasks  = 0;
+    state->BlockedThreads = 0;
+    state->Stopped        = false;
+}
+WorkerThreadPool::~WorkerThreadPool()
+{
+    // tasks that did not start are dropped, the running ones are waited for (except for the ones that may block)
+    std::unique_lock lock(state->Lock);
+    state->Stopped = true;
+    state->Tasks.clear();
+    state->TaskAdded.notify_all();
+    state->ThreadExited.wait(lock, [this] { return state->Threads == state->BlockedThreads; });
+}
+void WorkerThreadPool::WorkerMain(std::shared_ptr<State> state)
+{
+    std::unique_lock lock(state->Lock);
+    while (true)
+    {
+        state->IdleThreads++;
+        state->TaskAdded.wait(lock, [&state] { return state->Stopped || !state->Tasks.empty(); });
+        state->IdleThreads--;
+        if (state->Stopped)
+            break;
+        auto task = std::move(state->Tasks.front());
+        state->Tasks.pop_front();
+        state->BlockedThreads += task.MayBlock ? 1 : 0;
+        lock.unlock();
+        task.Run();
+        task.Run = nullptr; // the captures of the task are released outside the lock
+        lock.lock();
+        if (task.MayBlock)
+        {
+            state->BlockedThreads--;
+            state->BlockingTasks--;
+        }
+    }
+    state->Threads--;
+    state->ThreadExited.notify_all();
+}
+bool WorkerThreadPool::Run(std::function<void()> task, bool mayBlock)
+{
+    CHECK(task, false, "Expecting a valid task !");
+    {
+        std::scoped_lock lock(state->Lock);
+        CHECK(!state->Stopped, false, "Thread pool was stopped !");
+        state->Tasks.push_back({ std::move(task), mayBlock });
+        state->BlockingTasks += mayBlock ? 1 : 0;
+        // a task that may block gets a thread of its own --> it can not delay the other tasks
+        const auto maxThreads = std::max<size_t>(std::thread::hardware_concurrency(), 2) + state->BlockingTasks;
+        if ((state->Tasks.size() > state->IdleThreads) && (state->Threads < maxThreads))
+        {
+            std::thread(&WorkerThreadPool::WorkerMain, state).detach();
+            state->Threads++;
+        }
+    }
+    state->TaskAdded.notify_one();
+    return true;
+}
+void RunInParallel(uint32 count, const std::function<void(uint32)>& fnc)
+{
+    // the indexes are taken in order --> a task that starts after all of them were taken does nothing (and the
+    // captures of 'fnc' are only used for the indexes that were taken before this function returns)
+    struct ParallelCalls
+    {
+        std::function<void(uint32)> Fnc;
+        std::atomic<uint32> Next;
+        uint32 Finished;
+        std::mutex Lock;
+        std::condition_variable AllFinished;
+    };
+    auto calls      = std::make_shared<ParallelCalls>();
+    calls->Fnc      = fnc;
+    calls->Next     = 0;
+    calls->Finished = 0;
+    auto process    = [calls, count]()
+    {
+        uint32 finished = 0;
+        for (auto idx = calls->Next++; idx < count; idx = calls->Next++, finished++)
+            calls->Fnc(idx);
+        if (finished == 0)
+            return;
+        std::scoped_lock lock(calls->Lock);
+        calls->Finished += finished;
+        if (calls->Finished == count)
+            calls->AllFinished.notify_all();
+    };
+    auto app = Application::GetApplication();
+    for (uint32 idx = 1; (app) && (idx < count); idx++)
+        if (!app->Workers.Run(process))
+            break;
+    process();
+    std::unique_lock lock(calls->Lock);
+    calls->AllFinished.wait(lock, [&calls, count] { return calls->Finished == count; });
+}
+std::future<void> RunLongTask(std::function<void()> task)
+{
+    auto app = Application::GetApplication();
+    CHECK(app, std::future<void>(), "Application has not been initialized !");
+    auto packagedTask = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    auto result       = packagedTask->get_future();
+    CHECK(app->Workers.Run([packagedTask]() { (*packagedTask)(); }, true),
+          std::future<void>(),
+          "Fail to start a background task");
+    return result;
+}
+} // namespace AppCUI::Internal
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "Internal.hpp"
+#include <atomic>
+#include <mutex>
 #include <optional>
 #include <set>
+#include <thread>
 
 namespace AppCUI
 {
@@ -18,6 +21,7 @@ constexpr uint32 GATTR_TABSTOP  = 0x000008;
 constexpr uint32 GATTR_VSCROLL  = 0x000010;
 constexpr uint32 GATTR_HSCROLL  = 0x000020;
 constexpr uint32 GATTR_EXPANDED = 0x000040;
+constexpr uint32 GATTR_OPAQUE   = 0x000080; // the control paints every character of its area
 
 enum class LayoutFormatMode : uint16
 {
@@ -67,7 +71,7 @@ struct LayoutMetricData
 struct ControlContext
 {
   public:
-    Graphics::Clip ScreenClip, ExpandedViewClip;
+    Graphics::Clip ScreenClip, ExpandedViewClip, ParentClip;
     struct
     {
         struct
@@ -80,6 +84,7 @@ struct ControlContext
         int X, Y;
         int Width, MinWidth, MaxWidth;
         int Height, MinHeight, MaxHeight;
+        Graphics::Size LastClientSize; // client size used the last time the children were re-layouted
     } Layout;
     struct
     {
@@ -105,6 +110,7 @@ struct ControlContext
     Application::Config* Cfg;
     Graphics::CharacterBuffer Text;
     bool Inited, Focused, MouseIsOver, Started;
+    bool ScreenClipOutdated;
 
     // Handlers
     unique_ptr<Controls::Handlers::Control> handlers;
@@ -128,8 +134,21 @@ struct ControlContext
     bool RecomputeLayout_TopBottomAnchorsAndWidth(const LayoutMetricData& md);
 
     bool RecomputeLayout(Control* parent);
+    void InvalidateScreenClip();
     void PaintScrollbars(Graphics::Renderer& renderer);
 
+    inline bool IsLayoutDependentOnParentSize() const
+    {
+        // only a top-left anchored (x,y,w,h) layout with no percentages is independent of its parent size
+        if ((Layout.Format.LayoutMode != LayoutFormatMode::PointAndSize) ||
+            (Layout.Format.Anchor != Alignament::TopLeft))
+            return true;
+        return (Layout.Format.X.Type == LayoutValueType::Percentage) ||
+               (Layout.Format.Y.Type == LayoutValueType::Percentage) ||
+               (Layout.Format.Width.Type == LayoutValueType::Percentage) ||
+               (Layout.Format.Height.Type == LayoutValueType::Percentage);
+    }
+
     constexpr inline ControlState GetControlState(ControlStateFlags stateFlags)
     {
         if (!(Flags & GATTR_ENABLE))
@@ -360,6 +379,22 @@ class TextAreaControlContext : public ControlContext
     } Selection;
     char tabChar;
     Controls::Control* Host;
+    // read-only view of a memory mapped (UTF-8) file - lines are indexed in a background thread
+    struct
+    {
+        std::filesystem::path Path;
+        OS::MappedFile File; // re-mapped (under lock) when the file grows in follow mode
+        std::future<void> Indexer;
+        std::atomic<bool> Stop, Running, Indexing, Follow;
+        std::atomic<uint64> IndexedBytes;
+        uint64 FileID; // changed only by the indexer (in follow mode) --> used to detect a replaced file
+        std::atomic<uint32> LinesCount; // lines with a known end (that can be displayed)
+        uint32 PaintedLinesCount;
+        std::mutex Lock;
+        std::vector<uint64> LineStarts; // offset of every line (sorted)
+        std::vector<uint64> VisibleLineStarts;
+        std::vector<Character> Line; // decoded characters of the line that is being painted
+    } LargeFile;
 
     void ComputeVisibleLinesAndRows();
 
@@ -417,6 +452,24 @@ class TextAreaControlContext : public ControlContext
     bool OnMouseLeave();
     bool OnMouseEnter();
     bool OnEvent(Event eventType, int ID);
+
+    inline bool IsLargeFileMode() const
+    {
+        return !LargeFile.Path.empty();
+    }
+    bool OpenLargeFile(const std::filesystem::path& filePath);
+    void CloseLargeFile();
+    void IndexLargeFileLines(uint64 start, uint64 end, std::vector<uint64>& lines);
+    bool PublishLargeFileLines(std::vector<uint64>& lines, bool finished);
+    void RestartLargeFileIndexer();
+    void LargeFileIndexer(uint64 start);
+    void FollowLargeFile();
+    bool RemapLargeFile(uint64& indexedBytes);
+    bool SetLargeFileFollowMode(bool enabled);
+    bool DecodeLargeFileLine(uint64 start, uint64 end, uint32 skipCharacters, uint32 maxCharacters);
+    void LargeFileMoveTo(uint32 lineIndex);
+    void PaintLargeFile(Graphics::Renderer& renderer, int x, int y, const Graphics::ColorPair textColor);
+    bool OnLargeFileKeyEvent(Input::Key keyCode);
 };
 
 struct TabControlContext : public ControlContext
@@ -443,9 +496,49 @@ struct TabControlContext : public ControlContext
 struct CanvasControlContext : public ControlContext
 {
     Graphics::Canvas canvas;
+    Graphics::TiledCanvas tiledCanvas; // used instead of canvas for ViewerFlags::Tiled
     int CanvasScrollX, CanvasScrollY, mouseDragX, mouseDragY;
     bool dragModeEnabled;
     void MoveScrollTo(int newX, int newY);
+
+    inline uint32 GetCanvasWidth() const
+    {
+        return (Flags && Controls::ViewerFlags::Tiled) ? tiledCanvas.GetWidth() : canvas.GetWidth();
+    }
+    inline uint32 GetCanvasHeight() const
+    {
+        return (Flags && Controls::ViewerFlags::Tiled) ? tiledCanvas.GetHeight() : canvas.GetHeight();
+    }
+};
+
+constexpr uint32 IMAGEVIEW_MAX_SCALE_FACTOR   = 20;
+constexpr uint32 IMAGEVIEW_MAX_RENDERED_CACHE = 8;
+
+struct ImageViewControlContext : public CanvasControlContext
+{
+    struct RenderedImage
+    {
+        Graphics::ImageRenderingMethod Method;
+        Graphics::ImageScaleMethod Scale;
+        std::unique_ptr<Graphics::Canvas> Cells;
+    };
+    // identity of the image the caches below were computed for
+    struct
+    {
+        uint64 Hash;
+        uint32 Width, Height;
+    } Source;
+    // pyramid - every level (index = scale factor) is obtained by reducing a finer level (kept only while an image
+    // is converted, the rendered cells are the ones that are reused)
+    Graphics::Image ScaledImages[IMAGEVIEW_MAX_SCALE_FACTOR + 1];
+    // already converted cells (most recently used first)
+    std::vector<RenderedImage> RenderedImages;
+
+    void SetSource(const Graphics::Image& img);
+    void ReleaseScaledImages();
+    const Graphics::Image* GetScaledImage(const Graphics::Image& img, uint32 factor);
+    const Graphics::Canvas* GetRenderedImage(
+          const Graphics::Image& img, Graphics::ImageRenderingMethod method, Graphics::ImageScaleMethod scale);
 };
 
 constexpr uint32 MAX_LISTVIEW_COLUMNS     = 64;
@@ -671,6 +764,13 @@ enum class ListViewFilterMode : uint8
     Search,
     CustomHighlight
 };
+struct ListViewTypedColumn
+{
+    ListViewColumnType Type{ ListViewColumnType::Text };
+    NumericFormat Format{ NumericFormatFlags::None };
+    vector<uint64> Values; // raw values indexed by the item handle
+    vector<bool> HasValue; // items without a value show the text of the sub-item
+};
 class ListViewControlContext : public ColumnsHeaderViewControlContext
 {
   public:
@@ -679,13 +779,29 @@ class ListViewControlContext : public ColumnsHeaderViewControlContext
         vector<InternalListViewItem> List;
         Utils::Array32 Indexes;
         int FirstVisibleIndex, CurentItemIndex;
+        // lines used by every item (height + separator) in the order from Indexes - they are only needed if some
+        // items are taller than one line (otherwise the lines are computed directly from the positions)
+        Utils::FenwickTree Lines;
+        vector<uint32> Positions; // position of every item in Indexes (for the updates of Lines)
+        uint32 TallItems;
+        bool LinesValid;
     } Items;
 
+    vector<ListViewTypedColumn> TypedColumns;
+    CharacterBuffer FormattedCell; // the last typed cell that was formatted (overwritten by the next GetCellText)
+    CharacterBuffer SearchCell;    // copy of the painted cell that contains the search text (with the match colored)
+    Utils::TrigramIndex SearchIndex; // only used with ListViewFlags::SearchIndex
+
     struct
     {
         Utils::UnicodeStringBuilder SearchText;
         int LastFoundItem;
         ListViewFilterMode filterMode;
+        // Items.Indexes holds (at least) the items that match FilteredText in the FilteredColumns columns
+        Utils::UnicodeStringBuilder FilteredText;
+        uint64 FilteredColumns;
+        uint32 FilteredColumnsCount;
+        bool CanRefine; // false if an item was changed since the last filter pass
     } Filter;
 
     struct
@@ -718,9 +834,21 @@ class ListViewControlContext : public ColumnsHeaderViewControlContext
 
     // itemuri
     ItemHandle AddItem(const ConstString& text);
+    uint32 AddItems(uint32 count, const ItemsGenerator& getItem);
     bool SetItemText(ItemHandle item, uint32 subItem, const ConstString& text);
-    Graphics::CharacterBuffer* GetItemText(ItemHandle item, uint32 subItem);
+    const Graphics::CharacterBuffer* GetItemText(ItemHandle item, uint32 subItem);
+    bool GetItemFormattedText(ItemHandle item, uint32 subItem, CharacterBuffer& text);
     bool SetItemCheck(ItemHandle item, bool check);
+
+    // typed columns
+    bool SetColumnType(uint32 columnIndex, ListViewColumnType type, NumericFormat format);
+    template <typename T>
+    bool SetItemValue(ItemHandle item, uint32 subItem, T value);
+    bool HasItemValue(ItemHandle item, uint32 subItem) const;
+    uint64 GetItemSortKey(ItemHandle item, uint32 subItem) const;
+    CharacterBuffer& GetCellText(ItemHandle item, uint32 subItem);
+    int32 CompareItems(ItemHandle item1, ItemHandle item2, uint32 subItem) const;
+    bool SortByValues(uint32 columnIndex);
     bool SetItemSelect(ItemHandle item, bool select);
     bool SetItemColor(ItemHandle item, ColorPair color);
     bool SetItemColor(ItemHandle item, uint32 subItemIndex, ColorPair color);
@@ -743,6 +871,10 @@ class ListViewControlContext : public ColumnsHeaderViewControlContext
     int GetFirstVisibleLine();
     bool SetFirstVisibleLine(ItemHandle item);
     int GetVisibleItemsCount();
+    int GetVisibleLinesCount();
+    void UpdateItemsLines();
+    uint32 GetItemsLines(uint32 count);
+    uint32 GetItemAtLine(uint32 line);
 
     void CopyToClipboard(bool justCurrentItem);
 
@@ -769,8 +901,14 @@ class ListViewControlContext : public ColumnsHeaderViewControlContext
 
     uint32 ComputeColumnsPreferedWidth(uint32 columnIndex);
 
-    bool FilterItem(InternalListViewItem& lvi, bool clearColorForAll);
+    bool FilterItem(InternalListViewItem& lvi);
+    // position of the search text in the first searchable column that contains it (-1 if it is not found)
+    int32 FindSearchText(ItemHandle item, uint32& columnIndex);
     void FilterItems();
+    uint64 GetSearchableColumns();
+    void AddToSearchIndex(ItemHandle item);
+    void RemoveFromSearchIndex(ItemHandle item);
+    bool GetSearchCandidates(vector<uint32>& result);
 
     inline int GetLeftPos() const
     {
@@ -846,6 +984,24 @@ class NumericSelectorControlContext : public ControlContext
     bool PaintValue(Renderer& renderer);
 };
 
+// children of an item that are loaded on a worker thread (TreeViewItem::SetChildrenLoader)
+struct TreeChildrenLoad
+{
+    struct Child
+    {
+        vector<std::string> texts;
+        TreeViewChildrenLoader childrenLoader;
+    };
+
+    ItemHandle placeholder{ InvalidItemHandle }; // the "Loading ..." child (owned by the UI thread)
+
+    // shared with the worker thread
+    std::atomic<bool> stop{ false };
+    std::mutex lock;
+    vector<Child> pending;
+    bool finished{ false };
+};
+
 struct TreeItem
 {
     ItemHandle parent{ InvalidItemHandle };
@@ -861,6 +1017,8 @@ struct TreeItem
     TreeViewItem::Type type           = TreeViewItem::Type::Normal;
     ColorPair color;
     uint32 priority = 0;
+    TreeViewChildrenLoader childrenLoader{};
+    std::shared_ptr<TreeChildrenLoad> childrenLoad{}; // only while the children are being loaded
 };
 
 class TreeControlContext : public ColumnsHeaderViewControlContext
@@ -906,6 +1064,9 @@ class TreeControlContext : public ColumnsHeaderViewControlContext
         Utils::UnicodeStringBuilder searchText;
         FilterMode mode{ FilterMode::None };
     } filter{};
+    CharacterBuffer searchCell;      // copy of the painted value that contains the search text (with the match colored)
+    Utils::TrigramIndex searchIndex; // only used with TreeViewFlags::SearchIndex
+    vector<ItemHandle> loadingItems; // items whose children are loaded on a worker thread
 
     uint32 mouseOverColumnIndex          = 0xFFFFFFFF;
     uint32 mouseOverColumnSeparatorIndex = 0xFFFFFFFF;
@@ -940,16 +1101,22 @@ class TreeControlContext : public ColumnsHeaderViewControlContext
     bool IsMouseOnSearchField(int x, int y) const;
     bool AdjustElementsOnResize(const int newWidth, const int newHeight);
     bool AdjustItemsBoundsOnResize();
-    bool SetColorForItems(const Graphics::ColorPair& color);
     bool SearchItems();
     bool MarkAllItemsAsNotFound();
     bool MarkAllAncestorsWithChildFoundInFilterSearch(const ItemHandle handle);
     bool RemoveItem(const ItemHandle handle);
+    void AddToSearchIndex(const TreeItem& item);
+    void RemoveFromSearchIndex(const TreeItem& item);
+    bool StartChildrenLoad(const ItemHandle handle);
+    bool StopChildrenLoad(TreeItem& item);
+    void StopAllChildrenLoads();
+    bool ProcessLoadedChildren();
 
     GenericRef GetItemDataAsPointer(ItemHandle handle) const;
     bool SetItemDataAsPointer(ItemHandle item, GenericRef value);
 
     ItemHandle AddItem(ItemHandle parent, const std::initializer_list<ConstString> values, bool isExpandable = false);
+    uint32 AddItems(ItemHandle parent, uint32 count, const ItemsGenerator& getItem);
 
     // trigers
     void TriggerOnCurrentItemChanged();
@@ -971,6 +1138,22 @@ struct GridCellData
     std::u16string content;
 };
 
+// a rectangle of cells (all margins are included)
+struct GridCellRange
+{
+    uint32 startColumn, startRow, endColumn, endRow;
+
+    inline bool Contains(uint32 columnIndex, uint32 rowIndex) const
+    {
+        return (columnIndex >= startColumn) && (columnIndex <= endColumn) && (rowIndex >= startRow) &&
+               (rowIndex <= endRow);
+    }
+    inline uint64 GetCellsCount() const
+    {
+        return ((uint64) (endColumn - startColumn + 1)) * (endRow - startRow + 1);
+    }
+};
+
 class GridControlContext : public ControlContext
 {
   public:
@@ -979,8 +1162,11 @@ class GridControlContext : public ControlContext
     GridFlags flags         = GridFlags::None;
     uint32 hoveredCellIndex = 0xFFFFFFFF;
     uint32 anchorCellIndex  = 0xFFFFFFFF;
-    std::vector<uint32> selectedCellsIndexes;
+    std::vector<GridCellRange> selectedRanges; // a selection costs one entry per rectangle (not per cell)
     std::vector<uint32> duplicatedCellsIndexes;
+    // hash of the content --> cells (row * columnsNo + column) with that content. Empty cells are not indexed.
+    std::unordered_map<uint64, std::vector<uint32>> contentIndex;
+    bool contentIndexValid = false; // rebuilt (when needed) after the cells are sorted, filtered or resized
 
     int32 deltaX = 0U;
     int32 deltaY = 0U;
@@ -1040,8 +1226,25 @@ class GridControlContext : public ControlContext
     void SortColumn(int index);
     void FilterColumn(int columnIndex);
     void FindDuplicates();
+    void UpdateDuplicates(uint32 cellIndex);
     uint32 GetHeaderHeight() const;
     uint32 GetColumnSelected() const;
+
+    void SelectCells(uint32 fromCellIndex, uint32 toCellIndex);
+    bool IsCellSelected(uint32 columnIndex, uint32 rowIndex) const;
+    uint64 GetSelectedCellsCount() const;
+    bool GetSelectionBounds(GridCellRange& bounds) const;
+    bool GetVisibleCells(const GridCellRange& range, GridCellRange& visible) const;
+
+    void BuildContentIndex();
+    void AddToContentIndex(uint32 cellIndex);
+    void RemoveFromContentIndex(uint32 cellIndex);
+    void SetCellContent(uint32 columnIndex, uint32 rowIndex, GridCellData data);
+    void FindEqualCells(uint32 cellIndex, std::vector<uint32>& result);
+    uint32 CountDuplicatedCells();
+
+    bool ImportCSV(const std::filesystem::path& path, char separator, bool hasHeader);
+    bool ExportCSV(const std::filesystem::path& path, char separator, bool addHeader);
 };
 
 enum class MenuItemType : uint32
@@ -1310,6 +1513,60 @@ struct CharacterTableContext : public ControlContext
     }
 };
 
+constexpr uint32 HEXVIEW_SEARCH_CHUNK_SIZE  = 0x1000000; // bytes searched between two progress updates
+constexpr uint32 HEXVIEW_MAX_SEARCH_RESULTS = 0x100000;
+
+struct HexViewControlContext : public ControlContext
+{
+    struct
+    {
+        OS::MappedFile File;
+        std::unique_ptr<OS::DataObject> Object;
+        std::mutex ObjectLock; // the object is also read by the search thread
+        uint64 Size;
+    } Source;
+    // bytes of the visible lines (only for data objects - mapped files are accessed directly)
+    struct
+    {
+        std::vector<uint8> Buffer;
+        uint64 Offset;
+    } View;
+    struct
+    {
+        std::future<void> Worker;
+        std::atomic<bool> Stop, Running;
+        std::atomic<uint64> SearchedBytes;
+        std::atomic<uint64> ResultsCount; // updated after every chunk (used to know when to repaint)
+        uint64 PaintedResultsCount;
+        std::mutex ResultsLock;
+        std::vector<uint64> Results; // offsets of the matches (sorted)
+        std::vector<uint8> Pattern;
+    } Search;
+    uint64 TopOffset; // first byte of the first visible line
+    uint64 CursorOffset;
+    uint32 BytesPerLine;
+    uint32 OffsetDigits;
+    std::vector<Character> Line;
+    std::vector<uint8> Marks; // search result marks for the visible bytes
+
+    void ComputeLineSize();
+    uint32 GetHexColumn(uint32 index) const;
+    uint32 GetAsciiColumn(uint32 index) const;
+    uint32 GetVisibleLines() const;
+    void MoveTo(uint64 offset);
+    bool ReadBytes(uint64 offset, uint8* buffer, uint32 size);
+    const uint8* GetVisibleBytes(uint64 offset, uint32 size);
+    void MarkSearchResults(uint64 start, uint32 size);
+    void Paint(Graphics::Renderer& renderer);
+    bool OnKeyEvent(Input::Key keyCode);
+    void OnMousePressed(int x, int y);
+    void Close();
+    bool StartSearch(Utils::BufferView pattern);
+    void StopSearch();
+    void SearchWorker();
+    bool GoToSearchResult(bool next);
+};
+
 #define CREATE_CONTROL_CONTEXT(object, name, retValue)                                                                 \
     ControlContext* name = (ControlContext*) ((object)->Context);                                                      \
     if (name == nullptr)                                                                                               \
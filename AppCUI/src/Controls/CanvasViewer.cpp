@@ -4,8 +4,8 @@ namespace AppCUI
 {
 void CanvasControlContext::MoveScrollTo(int newX, int newY)
 {
-    const int imgWidth  = canvas.GetWidth();
-    const int imgHeight = canvas.GetHeight();
+    const int imgWidth  = GetCanvasWidth();
+    const int imgHeight = GetCanvasHeight();
     int viewWidth       = Layout.Width;
     int viewHeight      = Layout.Height;
 
@@ -29,7 +29,18 @@ void CanvasControlContext::MoveScrollTo(int newX, int newY)
 
 CanvasViewer::CanvasViewer(
       const ConstString& caption, string_view layout, uint32 canvasWidth, uint32 canvasHeight, ViewerFlags flags)
-    : Control(new CanvasControlContext(), caption, layout, true)
+    : CanvasViewer(new CanvasControlContext(), caption, layout, canvasWidth, canvasHeight, flags)
+{
+}
+// context MUST be a derivate of CanvasControlContext
+CanvasViewer::CanvasViewer(
+      void* context,
+      const ConstString& caption,
+      string_view layout,
+      uint32 canvasWidth,
+      uint32 canvasHeight,
+      ViewerFlags flags)
+    : Control(context, caption, layout, true)
 {
     auto Members = reinterpret_cast<CanvasControlContext*>(this->Context);
 
@@ -44,7 +55,15 @@ CanvasViewer::CanvasViewer(
     Members->mouseDragY                = 0;
     Members->dragModeEnabled           = false;
     Members->ScrollBars.OutsideControl = !(Members->Flags && ViewerFlags::Border);
-    ASSERT(Members->canvas.Create(canvasWidth, canvasHeight), "Fail to create a canvas of size object !");
+    if (Members->Flags && ViewerFlags::Tiled)
+    {
+        // tiles are allocated only when something is drawn over them
+        ASSERT(Members->tiledCanvas.Create(canvasWidth, canvasHeight), "Fail to create a tiled canvas !");
+    }
+    else
+    {
+        ASSERT(Members->canvas.Create(canvasWidth, canvasHeight), "Fail to create a canvas of size object !");
+    }
 }
 
 CanvasViewer::~CanvasViewer()
@@ -86,14 +105,11 @@ void CanvasViewer::Paint(Graphics::Renderer& renderer)
             return; // clipping is not visible --> no need to try to draw the rest
         left = top = 1;
     }
-    if (!this->IsEnabled())
-        renderer.DrawCanvas(
-              Members->CanvasScrollX + left,
-              Members->CanvasScrollY + top,
-              Members->canvas,
-              Members->Cfg->Text.Inactive);
+    const auto color = this->IsEnabled() ? NoColorPair : Members->Cfg->Text.Inactive;
+    if (Members->Flags && ViewerFlags::Tiled)
+        renderer.DrawCanvas(Members->CanvasScrollX + left, Members->CanvasScrollY + top, Members->tiledCanvas, color);
     else
-        renderer.DrawCanvas(Members->CanvasScrollX + left, Members->CanvasScrollY + top, Members->canvas);
+        renderer.DrawCanvas(Members->CanvasScrollX + left, Members->CanvasScrollY + top, Members->canvas, color);
 }
 
 void CanvasViewer::OnUpdateScrollBars()
@@ -103,16 +119,16 @@ void CanvasViewer::OnUpdateScrollBars()
     uint32 borderSize = Members->Flags && ViewerFlags::Border ? 2 : 0;
 
     // horizontal
-    if (Members->canvas.GetHeight() > (borderSize + (uint32) Members->Layout.Height))
+    if (Members->GetCanvasHeight() > (borderSize + (uint32) Members->Layout.Height))
         UpdateVScrollBar(
-              -Members->CanvasScrollY, Members->canvas.GetHeight() - (borderSize + (uint32) Members->Layout.Height));
+              -Members->CanvasScrollY, Members->GetCanvasHeight() - (borderSize + (uint32) Members->Layout.Height));
     else
         UpdateVScrollBar(-Members->CanvasScrollY, 0);
 
     // vertical
-    if (Members->canvas.GetWidth() > (borderSize + (uint32) Members->Layout.Width))
+    if (Members->GetCanvasWidth() > (borderSize + (uint32) Members->Layout.Width))
         UpdateHScrollBar(
-              -Members->CanvasScrollX, Members->canvas.GetWidth() - (borderSize + (uint32) Members->Layout.Width));
+              -Members->CanvasScrollX, Members->GetCanvasWidth() - (borderSize + (uint32) Members->Layout.Width));
     else
         UpdateHScrollBar(-Members->CanvasScrollX, 0);
 }
@@ -140,13 +156,13 @@ bool CanvasViewer::OnKeyEvent(Input::Key KeyCode, char16)
         Members->MoveScrollTo(0, Members->CanvasScrollY);
         return true;
     case Key::Ctrl | Key::Right:
-        Members->MoveScrollTo(-((int) Members->canvas.GetWidth()), Members->CanvasScrollY);
+        Members->MoveScrollTo(-((int) Members->GetCanvasWidth()), Members->CanvasScrollY);
         return true;
     case Key::Ctrl | Key::Up:
         Members->MoveScrollTo(Members->CanvasScrollX, 0);
         return true;
     case Key::Ctrl | Key::Down:
-        Members->MoveScrollTo(Members->CanvasScrollX, -((int) Members->canvas.GetHeight()));
+        Members->MoveScrollTo(Members->CanvasScrollX, -((int) Members->GetCanvasHeight()));
         return true;
 
     case Key::Shift | Key::Left:
@@ -166,7 +182,7 @@ bool CanvasViewer::OnKeyEvent(Input::Key KeyCode, char16)
         Members->MoveScrollTo(0, 0);
         return true;
     case Key::End:
-        Members->MoveScrollTo(-((int) Members->canvas.GetWidth()), -((int) Members->canvas.GetHeight()));
+        Members->MoveScrollTo(-((int) Members->GetCanvasWidth()), -((int) Members->GetCanvasHeight()));
         return true;
     default:
         break;
@@ -221,6 +237,13 @@ void Controls::CanvasViewer::OnMouseReleased(int x, int y, Input::MouseButton bu
 Reference<Canvas> CanvasViewer::GetCanvas()
 {
     CREATE_TYPECONTROL_CONTEXT(CanvasControlContext, Members, nullptr);
+    CHECK(!(Members->Flags && ViewerFlags::Tiled), nullptr, "Use GetTiledCanvas() for a tiled viewer");
     return Reference<Canvas>(&(Members->canvas));
 }
+Reference<TiledCanvas> CanvasViewer::GetTiledCanvas()
+{
+    CREATE_TYPECONTROL_CONTEXT(CanvasControlContext, Members, nullptr);
+    CHECK(Members->Flags && ViewerFlags::Tiled, nullptr, "The viewer was not created with ViewerFlags::Tiled");
+    return Reference<TiledCanvas>(&(Members->tiledCanvas));
+}
 } // namespace AppCUI
@@ -235,6 +235,10 @@ std::optional<uint32> ColumnsHeaderView::GetSortColumnIndex() const
 {
     return ICH->Header.GetSortColumnIndex();
 }
+SortDirection ColumnsHeaderView::GetSortDirection() const
+{
+    return ICH->Header.GetSortDirection();
+}
 Column ColumnsHeaderView::GetSortColumn()
 {
     auto colIndex = ICH->Header.GetSortColumnIndex();
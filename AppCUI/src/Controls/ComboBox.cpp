@@ -87,7 +87,7 @@ bool ComboBox_AddItem(
         // separators items don't have an index
         indexID = ComboBox::NO_ITEM_SELECTED;
     }
-    Members->Items.push_back(ComboBoxItem(caption, userData, indexID, separator));
+    Members->Items.emplace_back(caption, userData, indexID, separator);
     return true;
 }
 
@@ -335,6 +335,31 @@ bool ComboBox::AddItem(const ConstString& caption, GenericRef userData)
     }
     return true;
 }
+uint32 ComboBox::AddItems(uint32 count, const ItemsGenerator& getItem)
+{
+    CHECK(getItem, 0, "Expecting a valid items generator !");
+    CREATE_TYPECONTROL_CONTEXT(ComboBoxControlContext, Members, 0);
+    Members->Items.reserve(Members->Items.size() + count);
+    CHECK(Members->Indexes.Reserve(Members->Indexes.Len() + count), 0, "Fail to allocate %u indexes", count);
+
+    vector<string_view> texts;
+    uint32 added = 0;
+    while ((added < count) && (getItem(added, texts)))
+    {
+        CHECK(texts.size() > 0, added, "Expecting a caption for item #%u", added);
+        CHECK(ComboBox_AddItem(this, u8string_view((const char8*) texts[0].data(), texts[0].size()), false, 0ULL),
+              added,
+              "");
+        texts.clear();
+        added++;
+    }
+    if (Members->Items.size() > 0)
+    {
+        Members->CurentItemIndex  = 0;
+        Members->FirstVisibleItem = 0;
+    }
+    return added;
+}
 bool ComboBox::AddSeparator(const ConstString& caption)
 {
     return ComboBox_AddItem(this, caption, true, { nullptr });
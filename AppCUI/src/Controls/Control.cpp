@@ -481,6 +481,7 @@ ControlContext::ControlContext()
     this->Focused                                  = false;
     this->MouseIsOver                              = false;
     this->Started                                  = false;
+    this->ScreenClipOutdated                       = true;
     this->Cfg                                      = Application::GetAppConfig();
     this->HotKeyOffset                             = CharacterBuffer::INVALID_HOTKEY_OFFSET;
     this->ScrollBars.LeftMargin                    = 2;
@@ -957,6 +958,7 @@ bool ControlContext::RecomputeLayout(Control* controlParent)
     LayoutMetricData md;
     Graphics::Size sz;
 
+    InvalidateScreenClip();
     if (controlParent == nullptr)
         controlParent = this->Parent;
     if (controlParent != nullptr)
@@ -1022,6 +1024,16 @@ bool ControlContext::RecomputeLayout(Control* controlParent)
         RETURNERROR(false, "Unknwon layout format mode: %d", (int) this->Layout.Format.LayoutMode);
     }
 }
+void ControlContext::InvalidateScreenClip()
+{
+    // the entire chain of parents is marked as well so that ComputePositions can skip the unchanged branches
+    auto ctx = this;
+    while (ctx)
+    {
+        ctx->ScreenClipOutdated = true;
+        ctx                     = ctx->Parent ? reinterpret_cast<ControlContext*>(ctx->Parent->Context) : nullptr;
+    }
+}
 void ControlContext::PaintScrollbars(Graphics::Renderer& renderer)
 {
     int x, y;
@@ -1079,6 +1091,7 @@ void ControlContext::PaintScrollbars(Graphics::Renderer& renderer)
 //=======================================================================================================================================================
 Controls::Control::~Control()
 {
+    DisableFrameUpdates();
     DELETE_CONTROL_CONTEXT(ControlContext);
 }
 Controls::Control::Control(void* context, const ConstString& caption, string_view layout, bool computeHotKey)
@@ -1387,6 +1400,7 @@ void Controls::Control::MoveTo(int newX, int newY)
         return;
     CTRLC->Layout.X                                      = newX;
     CTRLC->Layout.Y                                      = newY;
+    CTRLC->InvalidateScreenClip();
     AppCUI::Application::GetApplication()->RepaintStatus = REPAINT_STATUS_ALL;
 }
 bool Controls::Control::Resize(int newWidth, int newHeight)
@@ -1416,15 +1430,29 @@ bool Controls::Control::Resize(int newWidth, int newHeight)
 
     CTRLC->Layout.Width  = newWidth;
     CTRLC->Layout.Height = newHeight;
+    CTRLC->InvalidateScreenClip();
     RecomputeLayout();
     return true;
 }
 void Controls::Control::RecomputeLayout()
 {
+    CTRLC->Layout.LastClientSize = GetClientSize();
     for (uint32 tr = 0; tr < CTRLC->ControlsCount; tr++)
     {
-        ((ControlContext*) (CTRLC->Controls[tr]->Context))->RecomputeLayout(this);
-        CTRLC->Controls[tr]->RecomputeLayout();
+        auto child        = CTRLC->Controls[tr];
+        auto childMembers = (ControlContext*) (child->Context);
+        const auto w      = childMembers->Layout.Width;
+        const auto h      = childMembers->Layout.Height;
+        // a child with an absolute (top-left, no percentages) layout keeps the same position and size
+        if (childMembers->IsLayoutDependentOnParentSize())
+            childMembers->RecomputeLayout(this);
+        // only go deeper if the child was resized or its client area has changed since its children were last
+        // re-layouted
+        const auto sz = child->GetClientSize();
+        if ((w != childMembers->Layout.Width) || (h != childMembers->Layout.Height) ||
+            (sz.Width != childMembers->Layout.LastClientSize.Width) ||
+            (sz.Height != childMembers->Layout.LastClientSize.Height))
+            child->RecomputeLayout();
     }
     OnAfterResize(CTRLC->Layout.Width, CTRLC->Layout.Height);
     AppCUI::Application::GetApplication()->RepaintStatus = REPAINT_STATUS_COMPUTE_POSITION;
@@ -1557,6 +1585,7 @@ bool Controls::Control::SetMargins(int left, int top, int right, int bottom)
     CTRLC->Margins.Right  = right;
     CTRLC->Margins.Top    = top;
     CTRLC->Margins.Bottom = bottom;
+    CTRLC->InvalidateScreenClip();
     return true;
 }
 Input::Key Controls::Control::GetHotKey()
@@ -1760,6 +1789,18 @@ bool Controls::Control::OnFrameUpdate()
 {
     return false;
 }
+void Controls::Control::EnableFrameUpdates(uint32 framesInterval)
+{
+    auto app = Application::GetApplication();
+    if (app)
+        app->FrameUpdates.Subscribe(this, framesInterval);
+}
+void Controls::Control::DisableFrameUpdates()
+{
+    auto app = Application::GetApplication();
+    if (app)
+        app->FrameUpdates.Unsubscribe(this);
+}
 void Controls::Control::OnAfterResize(int, int)
 {
 }
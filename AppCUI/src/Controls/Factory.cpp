@@ -483,6 +483,21 @@ Reference<Controls::CharacterTable> Factory::CharacterTable::Create(Controls::Co
 {
     return parent.AddControl<Controls::CharacterTable>(Factory::CharacterTable::Create(layout));
 }
+
+//======[HEXVIEW]====================================================================================
+Pointer<Controls::HexView> Factory::HexView::Create(string_view layout)
+{
+    return POINTER<Controls::HexView>(new Controls::HexView(layout));
+}
+Reference<Controls::HexView> Factory::HexView::Create(Controls::Control* parent, string_view layout)
+{
+    VALIDATE_PARENT;
+    return parent->AddControl<Controls::HexView>(Factory::HexView::Create(layout));
+}
+Reference<Controls::HexView> Factory::HexView::Create(Controls::Control& parent, string_view layout)
+{
+    return parent.AddControl<Controls::HexView>(Factory::HexView::Create(layout));
+}
 } // namespace AppCUI
 #undef VALIDATE_PARENT
 #undef POINTER
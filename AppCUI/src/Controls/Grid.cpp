@@ -25,6 +25,7 @@ constexpr auto InvalidCellIndex = 0xFFFFFFFFU;
 constexpr auto minCellWidth  = 0x03U;
 constexpr auto minCellHeight = 0x02U;
 constexpr size_t maxContentDisplayLength = 0x02U;
+constexpr uint32 GRID_FILTER_PROGRESS_ROWS = 0x10000U; // rows searched between two progress (and cancel) checks
 
 Grid::Grid(string_view layout, uint32 columnsNo, uint32 rowsNo, GridFlags flags)
     : Control(new GridControlContext(), "", layout, false)
@@ -129,11 +130,11 @@ bool Grid::OnKeyEvent(Input::Key keyCode, char16_t /*UnicodeChar*/)
         }
         break;
     case Input::Key::Escape:
-        if (context->selectedCellsIndexes.size() > 0)
+        if (!context->selectedRanges.empty())
         {
             if (!context->isCellContentRequested)
             {
-                context->selectedCellsIndexes.clear();
+                context->selectedRanges.clear();
                 context->duplicatedCellsIndexes.clear();
                 context->anchorCellIndex  = InvalidCellIndex;
                 context->hoveredCellIndex = InvalidCellIndex;
@@ -143,10 +144,20 @@ bool Grid::OnKeyEvent(Input::Key keyCode, char16_t /*UnicodeChar*/)
             return true;
         }
         break;
+    case Input::Key::Ctrl | Input::Key::A:
+        if (context->columnsNo > 0 && context->rowsNo > 0)
+        {
+            // a single range --> the size of the grid does not matter
+            context->anchorCellIndex = 0;
+            context->SelectCells(0, context->columnsNo * context->rowsNo - 1);
+            context->duplicatedCellsIndexes.clear();
+            return true;
+        }
+        break;
     case Input::Key::Ctrl | Input::Key::C:
         if (context->CopySelectedCellsContent())
         {
-            context->selectedCellsIndexes.clear();
+            context->selectedRanges.clear();
             context->hoveredCellIndex = InvalidCellIndex;
             context->anchorCellIndex  = InvalidCellIndex;
             return true;
@@ -263,12 +274,12 @@ void Grid::OnMousePressed(int x, int y, MouseButton button, Input::Key)
     case MouseButton::Left:
     {
         context->hoveredCellIndex = InvalidCellIndex;
-        context->selectedCellsIndexes.clear();
+        context->selectedRanges.clear();
         const auto index = context->ComputeCellNumber(x, y);
         if (index != InvalidCellIndex)
         {
             context->anchorCellIndex = index;
-            context->selectedCellsIndexes.emplace_back(index);
+            context->SelectCells(index, index);
         }
 
         if ((context->flags & GridFlags::Sort) != GridFlags::None)
@@ -336,32 +347,11 @@ bool Grid::OnMouseDrag(int x, int y, MouseButton button, Input::Key)
             break;
         }
 
-        context->selectedCellsIndexes.clear();
-        context->selectedCellsIndexes.emplace_back(currentIndex);
-
-        if (context->anchorCellIndex != currentIndex)
+        if (context->anchorCellIndex == InvalidCellIndex)
         {
-            const auto anchorColumnIndex = context->anchorCellIndex % context->columnsNo;
-            const auto anchorRowIndex    = context->anchorCellIndex / context->columnsNo;
-
-            const auto currentColumnIndex = currentIndex % context->columnsNo;
-            const auto currentRowIndex    = currentIndex / context->columnsNo;
-
-            const auto startColumnIndex = std::min<>(anchorColumnIndex, currentColumnIndex);
-            const auto startRowIndex    = std::min<>(anchorRowIndex, currentRowIndex);
-
-            const auto endColumnIndex = std::max<>(anchorColumnIndex, currentColumnIndex);
-            const auto endRowIndex    = std::max<>(anchorRowIndex, currentRowIndex);
-
-            for (auto i = startColumnIndex; i <= endColumnIndex; i++)
-            {
-                for (auto j = startRowIndex; j <= endRowIndex; j++)
-                {
-                    const auto current = context->columnsNo * j + i;
-                    context->selectedCellsIndexes.emplace_back(current);
-                }
-            }
+            context->anchorCellIndex = currentIndex;
         }
+        context->SelectCells(context->anchorCellIndex, currentIndex);
 
         if ((context->flags & GridFlags::DisableDuplicates) == GridFlags::None)
         {
@@ -474,7 +464,7 @@ bool Grid::OnMouseLeave()
 void Grid::OnLoseFocus()
 {
     auto context = reinterpret_cast<GridControlContext*>(Context);
-    context->selectedCellsIndexes.clear();
+    context->selectedRanges.clear();
 }
 
 bool Grid::OnEvent(Controls::Reference<Control>, Event eventType, int /*controlID*/)
@@ -553,19 +543,21 @@ bool Grid::UpdateCell(uint32 index, ConstString content, TextAlignament textAlig
 
     Utils::UnicodeStringBuilder usb{ content };
     std::u16string u16s(usb);
-    (*context->cells)[cellColumn][cellRow] = { textAlignment, u16s };
+    context->SetCellContent(cellColumn, cellRow, { textAlignment, u16s });
 
+    auto changedCellIndex = index;
     if ((context->flags & GridFlags::Sort) != GridFlags::None)
     {
         if (sort)
         {
             context->SortColumn(index % context->rowsNo);
+            changedCellIndex = InvalidCellIndex; // cells were moved --> the duplicates are searched again
         }
     }
 
     if ((context->flags & GridFlags::DisableDuplicates) == GridFlags::None)
     {
-        context->FindDuplicates();
+        context->UpdateDuplicates(changedCellIndex);
     }
 
     return true;
@@ -647,36 +639,26 @@ AppCUI::Graphics::Point Controls::Grid::GetSelectionLocationsStart() const
 {
     const auto context = reinterpret_cast<GridControlContext*>(Context);
 
-    if (context->selectedCellsIndexes.size() == 0)
+    GridCellRange bounds;
+    if (context->GetSelectionBounds(bounds) == false)
     {
         return { -1, -1 };
     }
 
-    const auto cell = context->selectedCellsIndexes[0];
-    if (cell == 0xFFFFFFFF)
-    {
-        return { -1, -1 };
-    }
-
-    return { static_cast<int32>(cell / context->columnsNo), static_cast<int32>(cell % context->columnsNo) };
+    return { static_cast<int32>(bounds.startRow), static_cast<int32>(bounds.startColumn) };
 }
 
 AppCUI::Graphics::Point Controls::Grid::GetSelectionLocationsEnd() const
 {
     const auto context = reinterpret_cast<GridControlContext*>(Context);
 
-    if (context->selectedCellsIndexes.size() == 0)
-    {
-        return { -1, -1 };
-    }
-
-    const auto cell = context->selectedCellsIndexes[context->selectedCellsIndexes.size() - 1];
-    if (cell == 0xFFFFFFFF)
+    GridCellRange bounds;
+    if (context->GetSelectionBounds(bounds) == false)
     {
         return { -1, -1 };
     }
 
-    return { static_cast<int32>(cell / context->columnsNo), static_cast<int32>(cell % context->columnsNo) };
+    return { static_cast<int32>(bounds.endRow), static_cast<int32>(bounds.endColumn) };
 }
 
 void Controls::Grid::SetDefaultHeaderValues()
@@ -796,6 +778,34 @@ std::optional<std::pair<std::string, std::vector<std::string>>> Grid::GetSelecte
     return std::make_pair(columnName, contents);
 }
 
+std::vector<uint32> Grid::FindEqualCells(uint32 index) const
+{
+    const auto context = reinterpret_cast<GridControlContext*>(Context);
+    std::vector<uint32> result;
+    CHECK(index < context->columnsNo * context->rowsNo, result, "Invalid cell index: %u", index);
+    context->FindEqualCells(index, result);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+uint32 Grid::GetDuplicatedCellsCount() const
+{
+    const auto context = reinterpret_cast<GridControlContext*>(Context);
+    return context->CountDuplicatedCells();
+}
+
+bool Grid::ImportCSV(const std::filesystem::path& path, char separator, bool hasHeader)
+{
+    const auto context = reinterpret_cast<GridControlContext*>(Context);
+    return context->ImportCSV(path, separator, hasHeader);
+}
+
+bool Grid::ExportCSV(const std::filesystem::path& path, char separator, bool addHeader) const
+{
+    const auto context = reinterpret_cast<GridControlContext*>(Context);
+    return context->ExportCSV(path, separator, addHeader);
+}
+
 std::optional<std::string> Grid::GetSelectedCellContent()
 {
     auto context                    = reinterpret_cast<GridControlContext*>(Context);
@@ -834,16 +844,29 @@ void GridControlContext::FilterColumn(int columnIndex)
     std::vector<uint32> filteredRows;
     filteredRows.reserve(rowsNo);
 
-    ProgressStatus::Init("Searching...", rowsNo);
-    LocalString<512> ls;
-    const char* format = "Reading [%d/%d] rows...";
-    for (auto rowIndex = 0; rowIndex < rowsNo; rowIndex++)
+    // the rows are read on a worker thread (the cells are not changed until the search is over)
+    const auto& column = (*cells)[columnIndex];
+    const auto& filter = columnsFilter[columnIndex];
+    auto search        = [&](ProgressStatus::Task& task)
     {
-        ProgressStatus::Update(rowIndex, ls.Format(format, rowIndex, rowsNo));
-        if ((*cells)[columnIndex][rowIndex].content.find(columnsFilter[columnIndex]) != std::u16string::npos)
+        LocalString<512> ls;
+        for (auto rowIndex = 0U; rowIndex < rowsNo; rowIndex++)
         {
-            filteredRows.push_back(rowIndex);
+            if ((rowIndex % GRID_FILTER_PROGRESS_ROWS) == 0)
+            {
+                if (task.IsCanceled())
+                    return;
+                task.Update(rowIndex, ls.Format("Reading [%u/%u] rows...", rowIndex, rowsNo));
+            }
+            if (column[rowIndex].content.find(filter) != std::u16string::npos)
+            {
+                filteredRows.push_back(rowIndex);
+            }
         }
+    };
+    if (!ProgressStatus::Run("Searching...", rowsNo, search))
+    {
+        return; // canceled --> the grid is not changed
     }
 
     if (filteredRows.empty())
@@ -865,8 +888,9 @@ void GridControlContext::FilterColumn(int columnIndex)
         newCells.push_back(tmpRow);
     }
 
-    *cells = newCells;
-    rowsNo = filteredRows.size();
+    *cells            = newCells;
+    rowsNo            = filteredRows.size();
+    contentIndexValid = false;
 }
 
 void GridControlContext::DrawBoxes(Renderer& renderer)
@@ -938,19 +962,18 @@ void GridControlContext::DrawBoxes(Renderer& renderer)
         renderer.DrawVerticalLine(xRight, yTop + 1, yBottom - 1, color);
     }
 
-    if (selectedCellsIndexes.size() > 0 && ((flags & GridFlags::HideSelectedCell) == GridFlags::None))
+    if (selectedRanges.size() > 0 && ((flags & GridFlags::HideSelectedCell) == GridFlags::None))
     {
         const auto color = Cfg->Cursor.Inactive;
 
-        // we assume these are already sorted
-        const auto startCellIndex = selectedCellsIndexes[0];
-        const auto endCellIndex   = selectedCellsIndexes[selectedCellsIndexes.size() - 1];
+        GridCellRange bounds;
+        GetSelectionBounds(bounds);
 
-        const auto sci = startCellIndex % columnsNo;
-        const auto sri = startCellIndex / columnsNo;
+        const auto sci = bounds.startColumn;
+        const auto sri = bounds.startRow;
 
-        const auto eci = endCellIndex % columnsNo + 1U;
-        const auto eri = endCellIndex / columnsNo + 1U;
+        const auto eci = bounds.endColumn + 1U;
+        const auto eri = bounds.endRow + 1U;
 
         const auto y1 = std::max<>(minY, (int) (offsetY + sri * cHeight));
         const auto y2 = std::max<>(minY, (int) (y1 + (eri - sri) * cHeight - 1));
@@ -1061,19 +1084,34 @@ void GridControlContext::DrawLines(Renderer& renderer)
         drawLines(hoveredCellIndex, GridCellStatus::Hovered);
     }
 
-    if (duplicatedCellsIndexes.size() > 0 && ((flags & GridFlags::DisableDuplicates) == GridFlags::None))
+    GridCellRange visible;
+    if (duplicatedCellsIndexes.size() > 0 && ((flags & GridFlags::DisableDuplicates) == GridFlags::None) &&
+        GetVisibleCells({ 0, 0, columnsNo - 1, rowsNo - 1 }, visible))
     {
         for (const auto& cellIndex : duplicatedCellsIndexes)
         {
-            drawLines(cellIndex, GridCellStatus::Duplicate);
+            if (visible.Contains(cellIndex % columnsNo, cellIndex / columnsNo))
+            {
+                drawLines(cellIndex, GridCellStatus::Duplicate);
+            }
         }
     }
 
-    if (selectedCellsIndexes.size() > 0 && ((flags & GridFlags::HideSelectedCell) == GridFlags::None))
+    if (selectedRanges.size() > 0 && ((flags & GridFlags::HideSelectedCell) == GridFlags::None))
     {
-        for (const auto& cellIndex : selectedCellsIndexes)
+        for (const auto& range : selectedRanges)
         {
-            drawLines(cellIndex, GridCellStatus::Selected);
+            if (GetVisibleCells(range, visible) == false)
+            {
+                continue;
+            }
+            for (auto rowIndex = visible.startRow; rowIndex <= visible.endRow; rowIndex++)
+            {
+                for (auto columnIndex = visible.startColumn; columnIndex <= visible.endColumn; columnIndex++)
+                {
+                    drawLines(rowIndex * columnsNo + columnIndex, GridCellStatus::Selected);
+                }
+            }
         }
     }
 }
@@ -1172,11 +1210,16 @@ void GridControlContext::DrawCellsBackground(Graphics::Renderer& renderer)
         }
     }
 
-    if (duplicatedCellsIndexes.size() > 0 && ((flags & GridFlags::DisableDuplicates) == GridFlags::None))
+    GridCellRange visible;
+    if (duplicatedCellsIndexes.size() > 0 && ((flags & GridFlags::DisableDuplicates) == GridFlags::None) &&
+        GetVisibleCells({ 0, 0, columnsNo - 1, rowsNo - 1 }, visible))
     {
         for (const auto& cellIndex : duplicatedCellsIndexes)
         {
-            DrawCellBackground(renderer, GridCellStatus::Duplicate, cellIndex);
+            if (visible.Contains(cellIndex % columnsNo, cellIndex / columnsNo))
+            {
+                DrawCellBackground(renderer, GridCellStatus::Duplicate, cellIndex);
+            }
         }
     }
 
@@ -1190,17 +1233,23 @@ void GridControlContext::DrawCellsBackground(Graphics::Renderer& renderer)
         }
     }
 
-    if (selectedCellsIndexes.size() > 0 && ((flags & GridFlags::HideSelectedCell) == GridFlags::None))
+    if (selectedRanges.size() > 0 && ((flags & GridFlags::HideSelectedCell) == GridFlags::None))
     {
-        for (const auto& cellIndex : selectedCellsIndexes)
+        for (const auto& range : selectedRanges)
         {
-            const auto columnIndex = cellIndex % columnsNo;
-            const auto rowIndex    = cellIndex / columnsNo;
-            if (columnIndex < toAddColumn || rowIndex < toAddRow)
+            if (GetVisibleCells(range, visible) == false)
             {
                 continue;
             }
-            DrawCellBackground(renderer, GridCellStatus::Selected, cellIndex);
+            const auto firstColumn = std::max<>(visible.startColumn, (uint32) std::max<>(0, toAddColumn));
+            const auto firstRow    = std::max<>(visible.startRow, (uint32) std::max<>(0, toAddRow));
+            for (auto columnIndex = firstColumn; columnIndex <= visible.endColumn; columnIndex++)
+            {
+                for (auto rowIndex = firstRow; rowIndex <= visible.endRow; rowIndex++)
+                {
+                    DrawCellBackground(renderer, GridCellStatus::Selected, columnIndex, rowIndex);
+                }
+            }
         }
     }
 }
@@ -1220,12 +1269,9 @@ void GridControlContext::DrawCellBackground(Graphics::Renderer& renderer, GridCe
         color = Cfg->Cursor.OverInactiveItem;
     }
 
-    for (auto& selectedCellIndex : selectedCellsIndexes)
+    if (IsCellSelected(i, j))
     {
-        if (selectedCellIndex == cellIndex)
-        {
-            color = Cfg->Cursor.OverInactiveItem;
-        }
+        color = Cfg->Cursor.OverInactiveItem;
     }
 
     renderer.FillRect(xLeft + 1, yTop + 1, xRight - 1, yBottom - 1, ' ', color);
@@ -1250,9 +1296,7 @@ bool GridControlContext::DrawCellContent(Graphics::Renderer& renderer, uint32 ce
     const auto& data = (*cells)[cellColumn][cellRow];
 
     const auto state = GetComponentState(
-          ControlStateFlags::All,
-          cellIndex == hoveredCellIndex,
-          std::find(selectedCellsIndexes.begin(), selectedCellsIndexes.end(), cellIndex) != selectedCellsIndexes.end());
+          ControlStateFlags::All, cellIndex == hoveredCellIndex, IsCellSelected(cellColumn, cellRow));
 
     ColorPair color = Cfg->Text.Normal;
 
@@ -1546,38 +1590,6 @@ void GridControlContext::UpdateGridParameters(bool dontRecomputeDimensions)
         offsetY = cHeight - 1 + offset / (int) cHeight * (int) cHeight;
         deltaY  = offsetY - cHeight + 1;
     }
-
-    // sort selected cells for better drawing
-    struct
-    {
-        const GridControlContext* gcc;
-        bool operator()(uint32 a, uint32 b)
-        {
-            const auto aci = a % gcc->columnsNo;
-            const auto ari = a / gcc->columnsNo;
-
-            const auto bci = b % gcc->columnsNo;
-            const auto bri = b / gcc->columnsNo;
-
-            if (ari < bri)
-            {
-                return true;
-            }
-            if (ari == bri)
-            {
-                if (aci < bci)
-                {
-                    return true;
-                }
-            }
-
-            return false;
-        };
-    } sortingComparator{ this };
-
-    std::sort(selectedCellsIndexes.begin(), selectedCellsIndexes.end(), sortingComparator);
-    selectedCellsIndexes.erase(
-          std::unique(selectedCellsIndexes.begin(), selectedCellsIndexes.end()), selectedCellsIndexes.end());
 }
 
 void GridControlContext::UpdateDimensions(int32 offsetX, int32 offsetY)
@@ -1611,25 +1623,25 @@ void GridControlContext::UpdatePositions(int32 offsetX, int32 offsetY)
 
 bool GridControlContext::MoveSelectedCellByKeys(Input::Key keyCode)
 {
-    if (selectedCellsIndexes.size() == 0)
+    if (selectedRanges.size() == 0)
     {
         if (isCellContentRequested)
         {
-            selectedCellsIndexes.emplace_back(anchorCellIndex);
+            SelectCells(anchorCellIndex, anchorCellIndex);
             return true;
         }
         else
         {
             anchorCellIndex = 0;
-            selectedCellsIndexes.emplace_back(0);
+            SelectCells(0, 0);
 
             return true;
         }
     }
 
-    if (selectedCellsIndexes.size() == 1)
+    if (GetSelectedCellsCount() == 1)
     {
-        const auto index = selectedCellsIndexes[0];
+        const auto index = selectedRanges[0].startRow * columnsNo + selectedRanges[0].startColumn;
         auto columnIndex = index % columnsNo;
         auto rowIndex    = index / columnsNo;
 
@@ -1654,8 +1666,8 @@ bool GridControlContext::MoveSelectedCellByKeys(Input::Key keyCode)
         const auto newCellIndex = columnsNo * rowIndex + columnIndex;
         if (newCellIndex != index)
         {
-            anchorCellIndex         = newCellIndex;
-            selectedCellsIndexes[0] = newCellIndex;
+            anchorCellIndex = newCellIndex;
+            SelectCells(newCellIndex, newCellIndex);
 
             const int xLeft  = offsetX + columnIndex * cWidth;
             const int xRight = offsetX + (columnIndex + 1) * cWidth;
@@ -1698,10 +1710,7 @@ bool GridControlContext::MoveSelectedCellByKeys(Input::Key keyCode)
 
             if ((flags & GridFlags::DisableDuplicates) == GridFlags::None)
             {
-                if (selectedCellsIndexes.size() == 1)
-                {
-                    FindDuplicates();
-                }
+                FindDuplicates();
             }
 
             return true;
@@ -1713,40 +1722,29 @@ bool GridControlContext::MoveSelectedCellByKeys(Input::Key keyCode)
 
 bool GridControlContext::SelectCellsByKeys(Input::Key keyCode)
 {
-    if (selectedCellsIndexes.size() == 0)
+    GridCellRange bounds;
+    if (GetSelectionBounds(bounds) == false)
     {
         anchorCellIndex = 0;
-        selectedCellsIndexes.emplace_back(0);
+        SelectCells(0, 0);
         return true;
     }
 
     const auto anchorColumnIndex = anchorCellIndex % columnsNo;
     const auto anchorRowIndex    = anchorCellIndex / columnsNo;
 
-    auto xLeft  = anchorColumnIndex;
-    auto xRight = anchorColumnIndex;
-
-    auto yTop = anchorRowIndex;
-    auto yBot = anchorRowIndex;
-
-    for (const auto& i : selectedCellsIndexes)
-    {
-        const auto colIndex = i % columnsNo;
-        const auto rowIndex = i / columnsNo;
+    auto xLeft  = std::min<>(anchorColumnIndex, bounds.startColumn);
+    auto xRight = std::max<>(anchorColumnIndex, bounds.endColumn);
 
-        xLeft  = std::min<>(xLeft, colIndex);
-        xRight = std::max<>(xRight, colIndex);
-
-        yTop = std::min<>(yTop, rowIndex);
-        yBot = std::max<>(yBot, rowIndex);
-    }
+    auto yTop = std::min<>(anchorRowIndex, bounds.startRow);
+    auto yBot = std::max<>(anchorRowIndex, bounds.endRow);
 
     const auto topLeft     = columnsNo * yTop + xLeft;
     const auto topRight    = columnsNo * yTop + xRight;
     const auto bottomLeft  = columnsNo * yBot + xLeft;
     const auto bottomRight = columnsNo * yBot + xRight;
 
-    if (selectedCellsIndexes.size() == 1)
+    if (bounds.GetCellsCount() == 1)
     {
         switch (keyCode)
         {
@@ -1867,19 +1865,11 @@ bool GridControlContext::SelectCellsByKeys(Input::Key keyCode)
         }
     }
 
-    selectedCellsIndexes.clear();
-    for (auto i = std::min<>(xLeft, xRight); i <= std::max<>(xLeft, xRight); i++)
-    {
-        for (auto j = std::min<>(yBot, yTop); j <= std::max<>(yBot, yTop); j++)
-        {
-            const auto current = columnsNo * j + i;
-            selectedCellsIndexes.emplace_back(current);
-        }
-    }
+    SelectCells(columnsNo * yTop + xLeft, columnsNo * yBot + xRight);
 
     if ((flags & GridFlags::DisableDuplicates) == GridFlags::None)
     {
-        if (selectedCellsIndexes.size() == 1)
+        if (GetSelectedCellsCount() == 1)
         {
             FindDuplicates();
         }
@@ -1890,33 +1880,21 @@ bool GridControlContext::SelectCellsByKeys(Input::Key keyCode)
 
 bool GridControlContext::CopySelectedCellsContent() const
 {
-    auto xLeft  = 0xFFFFFFFFU;
-    auto xRight = 0U;
-
-    auto yTop = 0xFFFFFFFFU;
-    auto yBot = 0U;
-
-    for (const auto& i : selectedCellsIndexes)
-    {
-        const auto colIndex = i % columnsNo;
-        const auto rowIndex = i / columnsNo;
-
-        xLeft  = std::min<>(xLeft, colIndex);
-        xRight = std::max<>(xRight, colIndex);
-
-        yTop = std::min<>(yTop, rowIndex);
-        yBot = std::max<>(yBot, rowIndex);
-    }
+    GridCellRange bounds;
+    CHECK(GetSelectionBounds(bounds), false, "No cells are selected !");
 
+    // cells that are within the bounds but not selected are copied as empty cells
     LocalUnicodeStringBuilder<2048> lusb;
-    for (auto j = std::min<>(yBot, yTop); j <= std::max<>(yBot, yTop); j++)
+    for (auto j = bounds.startRow; j <= bounds.endRow; j++)
     {
-        for (auto i = std::min<>(xLeft, xRight); i <= std::max<>(xLeft, xRight); i++)
+        for (auto i = bounds.startColumn; i <= bounds.endColumn; i++)
         {
-            const auto& content = (*cells)[i][j].content;
-            lusb.Add(content);
+            if (IsCellSelected(i, j))
+            {
+                lusb.Add((*cells)[i][j].content);
+            }
 
-            if (i < std::max<>(xLeft, xRight))
+            if (i < bounds.endColumn)
             {
                 lusb.Add(separator);
             }
@@ -1936,65 +1914,58 @@ bool GridControlContext::CopySelectedCellsContent() const
 
 bool GridControlContext::PasteContentToSelectedCells()
 {
-    // seems slow - a lower level parser might be better - we'll see
     LocalUnicodeStringBuilder<2048> lusb{};
     OS::Clipboard::GetText(lusb);
 
-    const std::u16string input{ lusb };
-
-    uint64 last = 0;
-    uint64 next = 0;
-    vector<std::u16string> lines;
-    lines.reserve(50);
-    while ((next = input.find(u"\n", last)) != std::string::npos)
-    {
-        lines.emplace_back(input.substr(last, next - last));
-        last = next + separator.length();
-    }
-    const auto lastLine = input.substr(last);
-    if (lastLine != u"")
-    {
-        lines.emplace_back(lastLine);
-    }
-
-    vector<std::u16string> tokens;
-    tokens.reserve(50);
-    for (const auto& line : lines)
-    {
-        uint64 last = 0;
-        uint64 next = 0;
-        while ((next = line.find(separator, last)) != std::string::npos)
-        {
-            tokens.emplace_back(line.substr(last, next - last));
+    const auto selectedCellsCount = GetSelectedCellsCount();
+    CHECK(selectedCellsCount > 0, false, "No cells are selected !");
+
+    // tokens are views in the clipboard text (split by lines and then by separator)
+    const std::u16string_view input{ lusb };
+    vector<std::u16string_view> tokens;
+    tokens.reserve(std::min<uint64>(selectedCellsCount, 1024U));
+    size_t lineStart = 0;
+    while (lineStart < input.size())
+    {
+        auto lineEnd = input.find(u'\n', lineStart);
+        if (lineEnd == std::u16string_view::npos)
+            lineEnd = input.size();
+        const auto line = input.substr(lineStart, lineEnd - lineStart);
+        size_t last     = 0;
+        size_t next     = 0;
+        while ((next = line.find(separator, last)) != std::u16string_view::npos)
+        {
+            tokens.push_back(line.substr(last, next - last));
             last = next + separator.length();
         }
-        tokens.emplace_back(line.substr(last));
+        tokens.push_back(line.substr(last));
+        lineStart = lineEnd + 1;
     }
 
-    if (tokens.size() > selectedCellsIndexes.size())
+    // extra tokens are concatenated into the last selected cell
+    std::u16string lastToken;
+    if (tokens.size() > selectedCellsCount)
     {
-        const auto start = tokens.begin() + selectedCellsIndexes.size() - 1U;
-
-        LocalUnicodeStringBuilder<2048> lusbLastToken;
-        for (vector<std::u16string>::iterator i = start; i != tokens.end(); i++)
-        {
-            lusbLastToken.Add(*i);
-        }
-
-        tokens.erase(start, tokens.end());
-
-        std::u16string lastToken{ lusbLastToken };
-        tokens.emplace_back(lastToken);
+        for (auto i = selectedCellsCount - 1U; i < tokens.size(); i++)
+            lastToken.append(tokens[i]);
+        tokens.resize(selectedCellsCount - 1U);
+        tokens.push_back(lastToken);
     }
 
-    auto index = selectedCellsIndexes.begin();
-    for (const auto& token : tokens)
+    // the tokens are placed row by row in every selected range
+    auto token = tokens.begin();
+    for (const auto& range : selectedRanges)
     {
-        const auto cellColumn = (*index) % columnsNo;
-        const auto cellRow    = (*index) / columnsNo;
-        auto& data            = cells->at(cellColumn).at(cellRow);
-        data.content          = token;
-        std::advance(index, 1);
+        for (auto rowIndex = range.startRow; (rowIndex <= range.endRow) && (token != tokens.end()); rowIndex++)
+        {
+            for (auto columnIndex = range.startColumn; (columnIndex <= range.endColumn) && (token != tokens.end());
+                 columnIndex++)
+            {
+                SetCellContent(
+                      columnIndex, rowIndex, { (*cells)[columnIndex][rowIndex].ta, std::u16string(*token) });
+                token++;
+            }
+        }
     }
 
     if ((flags & GridFlags::Sort) != GridFlags::None)
@@ -2027,6 +1998,7 @@ void GridControlContext::SetDefaultHeaderValues()
 
 void GridControlContext::ReserveMap()
 {
+    contentIndexValid = false;
     (*cells) = std::vector<std::vector<GridCellData>>(columnsNo);
     for (auto& column : *cells)
     {
@@ -2079,72 +2051,260 @@ void GridControlContext::SortColumn(int colIndex)
     {
         std::sort(column->begin(), column->end(), decSort);
     }
+    contentIndexValid = false; // the cells were moved
+}
+
+void GridControlContext::UpdateDuplicates(uint32 cellIndex)
+{
+    // only the changed cell is checked (instead of searching all the cells with the selected content again)
+    if (cellIndex == InvalidCellIndex || GetSelectedCellsCount() != 1)
+    {
+        FindDuplicates();
+        return;
+    }
+    const auto selectedCellIndex = selectedRanges[0].startRow * columnsNo + selectedRanges[0].startColumn;
+    const auto& selectedContent  = (*cells)[selectedRanges[0].startColumn][selectedRanges[0].startRow].content;
+    if (cellIndex == selectedCellIndex || selectedContent.empty())
+    {
+        FindDuplicates();
+        return;
+    }
+    const auto& content = (*cells)[cellIndex % columnsNo][cellIndex / columnsNo].content;
+    const auto it       = std::lower_bound(duplicatedCellsIndexes.begin(), duplicatedCellsIndexes.end(), cellIndex);
+    const auto found    = it != duplicatedCellsIndexes.end() && *it == cellIndex;
+    if (content == selectedContent && found == false)
+    {
+        duplicatedCellsIndexes.insert(it, cellIndex);
+    }
+    else if (content != selectedContent && found)
+    {
+        duplicatedCellsIndexes.erase(it);
+    }
 }
 
 void GridControlContext::FindDuplicates()
 {
     duplicatedCellsIndexes.clear();
-    CHECKRET(selectedCellsIndexes.size() == 1, "");
+    CHECKRET(GetSelectedCellsCount() == 1, "");
+
+    // all the cells (not only the visible ones) --> they remain valid when the grid is scrolled
+    FindEqualCells(selectedRanges[0].startRow * columnsNo + selectedRanges[0].startColumn, duplicatedCellsIndexes);
 
-    const auto cellColumn = selectedCellsIndexes[0] % columnsNo;
-    const auto cellRow    = selectedCellsIndexes[0] / columnsNo;
+    // sort duplicate cells (by row and then by column) for better drawing
+    std::sort(duplicatedCellsIndexes.begin(), duplicatedCellsIndexes.end());
+}
+
+uint32 GridControlContext::GetHeaderHeight() const
+{
+    return cHeight * (1 + ((flags & GridFlags::Filter) != GridFlags::None));
+}
+
+uint32 GridControlContext::GetColumnSelected() const
+{
+    CHECK(GetSelectedCellsCount() == 1, -1, "");
+    return selectedRanges[0].startColumn;
+}
 
-    const auto& content = (*cells)[cellColumn][cellRow].content;
-    for (auto columnIndex = START(offsetX, cWidth); columnIndex < END(Layout.Width, offsetX, cWidth, columnsNo);
-         columnIndex++)
+void GridControlContext::SelectCells(uint32 fromCellIndex, uint32 toCellIndex)
+{
+    const auto fromColumn = fromCellIndex % columnsNo;
+    const auto fromRow    = fromCellIndex / columnsNo;
+    const auto toColumn   = toCellIndex % columnsNo;
+    const auto toRow      = toCellIndex / columnsNo;
+
+    selectedRanges.clear();
+    selectedRanges.push_back({ std::min<>(fromColumn, toColumn),
+                               std::min<>(fromRow, toRow),
+                               std::max<>(fromColumn, toColumn),
+                               std::max<>(fromRow, toRow) });
+}
+
+bool GridControlContext::IsCellSelected(uint32 columnIndex, uint32 rowIndex) const
+{
+    for (const auto& range : selectedRanges)
     {
-        for (auto rowIndex = START(offsetY, cHeight); rowIndex < END(Layout.Height, offsetY, cHeight, rowsNo);
-             rowIndex++)
+        if (range.Contains(columnIndex, rowIndex))
         {
-            if (content.compare((*cells)[columnIndex][rowIndex].content) == 0)
-            {
-                const auto key = rowIndex * columnsNo + columnIndex;
-                duplicatedCellsIndexes.emplace_back(key);
-            }
+            return true;
         }
     }
+    return false;
+}
 
-    // sort duplicate cells for better drawing
-    struct
+uint64 GridControlContext::GetSelectedCellsCount() const
+{
+    // ranges do not overlap
+    uint64 count = 0;
+    for (const auto& range : selectedRanges)
     {
-        const GridControlContext* gcc;
-        bool operator()(uint32 a, uint32 b)
-        {
-            const auto aci = a % gcc->columnsNo;
-            const auto ari = a / gcc->columnsNo;
+        count += range.GetCellsCount();
+    }
+    return count;
+}
+
+bool GridControlContext::GetSelectionBounds(GridCellRange& bounds) const
+{
+    CHECK(selectedRanges.size() > 0, false, "");
+    bounds = selectedRanges[0];
+    for (const auto& range : selectedRanges)
+    {
+        bounds.startColumn = std::min<>(bounds.startColumn, range.startColumn);
+        bounds.startRow    = std::min<>(bounds.startRow, range.startRow);
+        bounds.endColumn   = std::max<>(bounds.endColumn, range.endColumn);
+        bounds.endRow      = std::max<>(bounds.endRow, range.endRow);
+    }
+    return true;
+}
 
-            const auto bci = b % gcc->columnsNo;
-            const auto bri = b / gcc->columnsNo;
+bool GridControlContext::GetVisibleCells(const GridCellRange& range, GridCellRange& visible) const
+{
+    const auto firstColumn = (uint32) START(offsetX, cWidth);
+    const auto firstRow    = (uint32) START(offsetY, cHeight);
+    const auto endColumn   = (uint32) std::max<>(0, END(Layout.Width, offsetX, cWidth, columnsNo));
+    const auto endRow      = (uint32) std::max<>(0, END(Layout.Height, offsetY, cHeight, rowsNo));
+
+    visible.startColumn = std::max<>(range.startColumn, firstColumn);
+    visible.startRow    = std::max<>(range.startRow, firstRow);
+    visible.endColumn   = std::min<>(range.endColumn, endColumn - 1);
+    visible.endRow      = std::min<>(range.endRow, endRow - 1);
+    return (endColumn > 0) && (endRow > 0) && (visible.startColumn <= visible.endColumn) &&
+           (visible.startRow <= visible.endRow);
+}
 
-            if (ari < bri)
-            {
-                return true;
-            }
-            if (ari == bri)
+static uint64 ComputeContentHash(const std::u16string& content)
+{
+    return std::hash<std::u16string>{}(content);
+}
+
+void GridControlContext::BuildContentIndex()
+{
+    contentIndex.clear();
+    for (auto columnIndex = 0U; columnIndex < cells->size(); columnIndex++)
+    {
+        const auto& column = (*cells)[columnIndex];
+        for (auto rowIndex = 0U; rowIndex < column.size(); rowIndex++)
+        {
+            const auto& content = column[rowIndex].content;
+            if (content.empty() == false)
             {
-                if (aci < bci)
-                {
-                    return true;
-                }
+                contentIndex[ComputeContentHash(content)].push_back(rowIndex * columnsNo + columnIndex);
             }
+        }
+    }
+    contentIndexValid = true;
+}
 
-            return false;
-        };
-    } sortingComparator{ this };
-    std::sort(duplicatedCellsIndexes.begin(), duplicatedCellsIndexes.end(), sortingComparator);
-    duplicatedCellsIndexes.erase(
-          std::unique(duplicatedCellsIndexes.begin(), duplicatedCellsIndexes.end()), duplicatedCellsIndexes.end());
+void GridControlContext::AddToContentIndex(uint32 cellIndex)
+{
+    const auto& content = (*cells)[cellIndex % columnsNo][cellIndex / columnsNo].content;
+    if (content.empty() == false)
+    {
+        contentIndex[ComputeContentHash(content)].push_back(cellIndex);
+    }
 }
 
-uint32 GridControlContext::GetHeaderHeight() const
+void GridControlContext::RemoveFromContentIndex(uint32 cellIndex)
 {
-    return cHeight * (1 + ((flags & GridFlags::Filter) != GridFlags::None));
+    const auto& content = (*cells)[cellIndex % columnsNo][cellIndex / columnsNo].content;
+    if (content.empty())
+    {
+        return;
+    }
+    auto bucket = contentIndex.find(ComputeContentHash(content));
+    CHECKRET(bucket != contentIndex.end(), "Cell %u is not indexed !", cellIndex);
+    auto& bucketCells = bucket->second;
+    auto it           = std::find(bucketCells.begin(), bucketCells.end(), cellIndex);
+    CHECKRET(it != bucketCells.end(), "Cell %u is not indexed !", cellIndex);
+    *it = bucketCells.back(); // the order of the cells within a bucket does not matter
+    bucketCells.pop_back();
+    if (bucketCells.empty())
+    {
+        contentIndex.erase(bucket);
+    }
 }
 
-uint32 GridControlContext::GetColumnSelected() const
+void GridControlContext::SetCellContent(uint32 columnIndex, uint32 rowIndex, GridCellData data)
 {
-    CHECK(selectedCellsIndexes.size() == 1, -1, "");
-    return static_cast<int32>(selectedCellsIndexes[0] / columnsNo);
+    // the index (if it was already built) is kept up to date --> no full scan is needed for the next query
+    const auto cellIndex = rowIndex * columnsNo + columnIndex;
+    if (contentIndexValid)
+    {
+        RemoveFromContentIndex(cellIndex);
+    }
+    (*cells)[columnIndex][rowIndex] = std::move(data);
+    if (contentIndexValid)
+    {
+        AddToContentIndex(cellIndex);
+    }
+}
+
+void GridControlContext::FindEqualCells(uint32 cellIndex, std::vector<uint32>& result)
+{
+    const auto& content = (*cells)[cellIndex % columnsNo][cellIndex / columnsNo].content;
+    if (content.empty())
+    {
+        return;
+    }
+    if (contentIndexValid == false)
+    {
+        BuildContentIndex();
+    }
+    const auto bucket = contentIndex.find(ComputeContentHash(content));
+    if (bucket == contentIndex.end())
+    {
+        return;
+    }
+    for (const auto index : bucket->second)
+    {
+        // different strings can have the same hash
+        if ((*cells)[index % columnsNo][index / columnsNo].content == content)
+        {
+            result.push_back(index);
+        }
+    }
+}
+
+uint32 GridControlContext::CountDuplicatedCells()
+{
+    if (contentIndexValid == false)
+    {
+        BuildContentIndex();
+    }
+    uint32 count = 0;
+    std::unordered_map<std::u16string_view, uint32> collisions;
+    for (const auto& [hash, bucketCells] : contentIndex)
+    {
+        if (bucketCells.size() < 2)
+        {
+            continue;
+        }
+        const auto& first = (*cells)[bucketCells[0] % columnsNo][bucketCells[0] / columnsNo].content;
+        auto allEqual     = true;
+        for (const auto index : bucketCells)
+        {
+            if ((*cells)[index % columnsNo][index / columnsNo].content != first)
+            {
+                allEqual = false;
+                break;
+            }
+        }
+        if (allEqual)
+        {
+            count += (uint32) bucketCells.size();
+            continue;
+        }
+        // hash collision --> the cells of this bucket are grouped by their content
+        collisions.clear();
+        for (const auto index : bucketCells)
+        {
+            collisions[(*cells)[index % columnsNo][index / columnsNo].content]++;
+        }
+        for (const auto& [content, contentCount] : collisions)
+        {
+            count += contentCount > 1 ? contentCount : 0;
+        }
+    }
+    return count;
 }
 
 } // namespace AppCUI
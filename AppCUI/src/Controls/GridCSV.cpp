@@ -0,0 +1,375 @@
+#include "ControlContext.hpp"
+#include <bit>
+#include <cstring>
+
+namespace AppCUI
+{
+constexpr uint64 GRID_CSV_PROGRESS_BYTES = 0x100000U; // how often (in bytes) the import progress is updated
+constexpr uint32 GRID_CSV_PROGRESS_ROWS  = 0x10000U;  // how often (in rows) the export progress is updated
+constexpr size_t GRID_CSV_WRITE_CHUNK    = 0x100000U; // exported text is written to the file in chunks of this size
+
+struct GridCSVTable
+{
+    std::vector<std::vector<GridCellData>> columns;
+    std::vector<GridCellData> header;
+    uint32 rowsNo         = 0;
+    size_t reservedRowsNo = 0;
+
+    std::u16string& AddCell(uint32 column)
+    {
+        if (column >= columns.size())
+        {
+            // a new column --> the previous rows have it empty
+            auto& newColumn = columns.emplace_back();
+            newColumn.reserve(reservedRowsNo);
+            newColumn.resize(rowsNo);
+        }
+        return columns[column].emplace_back().content;
+    }
+};
+
+// returns the first byte that is equal to b1 or b2 (or end if none is found)
+// 8 bytes are checked at once (a zero byte in (word ^ pattern) marks a match)
+static const uint8* CSVFindFirstOf(const uint8* p, const uint8* end, uint8 b1, uint8 b2)
+{
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        constexpr uint64 LOW_BITS  = 0x0101010101010101ULL;
+        constexpr uint64 HIGH_BITS = 0x8080808080808080ULL;
+        const uint64 pattern1      = LOW_BITS * b1;
+        const uint64 pattern2      = LOW_BITS * b2;
+        while (end - p >= 8)
+        {
+            uint64 word;
+            memcpy(&word, p, 8);
+            const auto x1 = word ^ pattern1;
+            const auto x2 = word ^ pattern2;
+            // only the lowest flagged byte is guaranteed to be a match (that is the only one we need)
+            const auto found = (((x1 - LOW_BITS) & ~x1) | ((x2 - LOW_BITS) & ~x2)) & HIGH_BITS;
+            if (found)
+                return p + (std::countr_zero(found) >> 3);
+            p += 8;
+        }
+    }
+    while ((p < end) && (*p != b1) && (*p != b2))
+        p++;
+    return p;
+}
+
+// appends an UTF-8 buffer to a cell (invalid sequences are considered to be Latin-1 characters)
+static void CSVAppendText(std::u16string& output, const uint8* p, const uint8* end)
+{
+    const auto start = output.size();
+    const auto size  = static_cast<size_t>(end - p);
+    output.resize(start + size);
+    auto d     = output.data() + start;
+    uint8 bits = 0;
+    for (size_t idx = 0; idx < size; idx++)
+    {
+        d[idx] = p[idx];
+        bits |= p[idx];
+    }
+    if (bits < 0x80)
+        return; // ASCII (the most common case)
+
+    output.resize(start);
+    while (p < end)
+    {
+        const auto ch = *p;
+        uint32 value  = ch;
+        uint32 length = 1;
+        if ((ch >= 0xC2) && (ch <= 0xF4))
+        {
+            length = ch >= 0xF0 ? 4 : (ch >= 0xE0 ? 3 : 2);
+            value  = ch & (0x7F >> length);
+            for (uint32 idx = 1; idx < length; idx++)
+            {
+                if ((p + idx >= end) || ((p[idx] & 0xC0) != 0x80))
+                {
+                    length = 1;
+                    value  = ch;
+                    break;
+                }
+                value = (value << 6) | (p[idx] & 0x3F);
+            }
+        }
+        if (value >= 0x10000)
+        {
+            value -= 0x10000;
+            output.push_back(static_cast<char16>(0xD800 + (value >> 10)));
+            output.push_back(static_cast<char16>(0xDC00 + (value & 0x3FF)));
+        }
+        else
+            output.push_back(static_cast<char16>(value));
+        p += length;
+    }
+}
+
+static bool CSVParse(
+      const uint8* data,
+      const uint8* end,
+      uint8 separator,
+      bool hasHeader,
+      GridCSVTable& table,
+      ProgressStatus::Task& task)
+{
+    auto p = data;
+    if ((end - p >= 3) && (p[0] == 0xEF) && (p[1] == 0xBB) && (p[2] == 0xBF))
+        p += 3; // UTF-8 BOM
+
+    // the number of lines is an upper bound for the number of rows --> columns are never reallocated
+    table.reservedRowsNo = 1;
+    for (auto line = p; (line = reinterpret_cast<const uint8*>(memchr(line, '\n', end - line))) != nullptr; line++)
+        table.reservedRowsNo++;
+
+    auto nextProgress = p + GRID_CSV_PROGRESS_BYTES;
+    bool headerRow    = hasHeader;
+    uint32 column     = 0;
+    while (p < end)
+    {
+        // the field is decoded directly into its cell
+        std::u16string* content;
+        if (headerRow)
+        {
+            content = &table.header.emplace_back().content;
+        }
+        else
+        {
+            content = &table.AddCell(column);
+        }
+
+        if (*p == '"')
+        {
+            p++;
+            while (p < end)
+            {
+                auto quote = reinterpret_cast<const uint8*>(memchr(p, '"', end - p));
+                if (!quote)
+                {
+                    CSVAppendText(*content, p, end); // unterminated quote --> the rest of the file
+                    p = end;
+                    break;
+                }
+                CSVAppendText(*content, p, quote);
+                p = quote + 1;
+                if ((p >= end) || (*p != '"'))
+                    break;
+                content->push_back(u'"'); // "" --> "
+                p++;
+            }
+        }
+        // unquoted text (or whatever follows a closing quote) up to the next separator or new line
+        const auto next = CSVFindFirstOf(p, end, separator, '\n');
+        auto textEnd    = next;
+        if ((next < end) && (*next == '\n') && (textEnd > p) && (textEnd[-1] == '\r'))
+            textEnd--;
+        CSVAppendText(*content, p, textEnd);
+        p = next;
+
+        if ((p < end) && (*p == separator))
+        {
+            p++;
+            column++;
+            if (p < end)
+                continue;
+            // a separator at the end of the file --> one more (empty) field
+            if (headerRow)
+                table.header.emplace_back();
+            else
+                table.AddCell(column);
+        }
+        else if (p < end)
+            p++; // new line
+
+        // end of the record
+        column = 0;
+        if (headerRow)
+        {
+            headerRow = false;
+            continue;
+        }
+        table.rowsNo++;
+        for (auto& c : table.columns)
+            if (c.size() < table.rowsNo)
+                c.emplace_back(); // short rows --> the missing fields are empty
+        if (p >= nextProgress)
+        {
+            task.Update(p - data);
+            if (task.IsCanceled())
+                return false;
+            nextProgress = p + GRID_CSV_PROGRESS_BYTES;
+        }
+    }
+    return true;
+}
+
+// UTF-8 encoded field (quoted only if it contains the separator, quotes or new lines)
+static void CSVAddField(std::string& output, const std::u16string& text, char16 separator)
+{
+    bool quoted = false;
+    for (auto ch : text)
+    {
+        if ((ch == separator) || (ch == u'"') || (ch == u'\n') || (ch == u'\r'))
+        {
+            quoted = true;
+            break;
+        }
+    }
+    if (quoted)
+        output.push_back('"');
+    const auto count = text.size();
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        uint32 ch = text[idx];
+        if (ch < 0x80)
+        {
+            if (ch == '"')
+                output.push_back('"');
+            output.push_back(static_cast<char>(ch));
+            continue;
+        }
+        if ((ch >= 0xD800) && (ch < 0xDC00) && (idx + 1 < count) && (text[idx + 1] >= 0xDC00) &&
+            (text[idx + 1] < 0xE000))
+        {
+            ch = 0x10000 + ((ch - 0xD800) << 10) + (text[idx + 1] - 0xDC00); // surrogate pair
+            idx++;
+        }
+        if (ch < 0x800)
+        {
+            output.push_back(static_cast<char>(0xC0 | (ch >> 6)));
+        }
+        else if (ch < 0x10000)
+        {
+            output.push_back(static_cast<char>(0xE0 | (ch >> 12)));
+            output.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+        }
+        else
+        {
+            output.push_back(static_cast<char>(0xF0 | (ch >> 18)));
+            output.push_back(static_cast<char>(0x80 | ((ch >> 12) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+        }
+        output.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+    }
+    if (quoted)
+        output.push_back('"');
+}
+
+bool GridControlContext::ImportCSV(const std::filesystem::path& path, char separator, bool hasHeader)
+{
+    CHECK((separator != '"') && (separator != '\n') && (separator != '\r'),
+          false,
+          "Invalid separator: %d",
+          separator);
+    OS::MappedFile file;
+    CHECK(file.OpenRead(path), false, "Fail to open: %s", path.string().c_str());
+
+    GridCSVTable table;
+    bool parsed = false;
+    auto parse  = [&](ProgressStatus::Task& task)
+    {
+        parsed = CSVParse(
+              file.GetData(), file.GetData() + file.GetSize(), static_cast<uint8>(separator), hasHeader, table, task);
+    };
+    if ((!ProgressStatus::Run("Loading ...", file.GetSize(), parse)) || (!parsed))
+        return false; // canceled --> the grid is not changed
+    file.Close();
+
+    const auto columns = std::max<>(table.columns.size(), table.header.size());
+    CHECK(columns > 0, false, "No columns found in: %s", path.string().c_str());
+    CHECK((uint64) columns * table.rowsNo < 0xFFFFFFFFU, false, "Too many cells !");
+    for (auto& c : table.columns)
+        c.resize(table.rowsNo);
+    table.columns.resize(columns, std::vector<GridCellData>(table.rowsNo));
+
+    cellsNormal = std::move(table.columns);
+    cellsFiltered.clear();
+    cells     = &cellsNormal;
+    columnsNo = static_cast<uint32>(columns);
+    rowsNo    = table.rowsNo;
+    columnsSort.assign(columnsNo, true);
+    columnsFilter.assign(columnsNo, u"");
+    if (hasHeader)
+    {
+        table.header.resize(columnsNo);
+        headers.clear();
+        headers.push_back({ TextAlignament::Center, u"Index" });
+        headers.insert(headers.end(), table.header.begin(), table.header.end());
+    }
+    else
+        SetDefaultHeaderValues();
+
+    selectedRanges.clear();
+    duplicatedCellsIndexes.clear();
+    hoveredCellIndex  = 0xFFFFFFFFU;
+    anchorCellIndex   = 0xFFFFFFFFU;
+    contentIndexValid = false;
+    UpdateGridParameters();
+    return true;
+}
+
+bool GridControlContext::ExportCSV(const std::filesystem::path& path, char separator, bool addHeader)
+{
+    // the content is written in a temporary file --> a canceled or failed export does not change the existing file
+    auto tempPath = path;
+    tempPath += ".tmp";
+    OS::File file;
+    CHECK(file.Create(tempPath, true), false, "Fail to create: %s", tempPath.string().c_str());
+
+    bool written = true;
+    auto write   = [&](ProgressStatus::Task& task)
+    {
+        std::string chunk;
+        chunk.reserve(GRID_CSV_WRITE_CHUNK * 2);
+        const auto sep = static_cast<char16>(separator);
+        if (addHeader)
+        {
+            for (auto columnIndex = 0U; columnIndex < columnsNo; columnIndex++)
+            {
+                if (columnIndex + 1U < headers.size())
+                    CSVAddField(chunk, headers[columnIndex + 1U].content, sep);
+                chunk.push_back(columnIndex + 1U < columnsNo ? separator : '\n');
+            }
+        }
+        for (auto rowIndex = 0U; rowIndex < rowsNo; rowIndex++)
+        {
+            for (auto columnIndex = 0U; columnIndex < columnsNo; columnIndex++)
+            {
+                CSVAddField(chunk, (*cells)[columnIndex][rowIndex].content, sep);
+                chunk.push_back(columnIndex + 1U < columnsNo ? separator : '\n');
+            }
+            if (chunk.size() >= GRID_CSV_WRITE_CHUNK)
+            {
+                written = file.Write(chunk.data(), static_cast<uint32>(chunk.size()));
+                chunk.clear();
+                if (!written)
+                    return;
+            }
+            if ((rowIndex % GRID_CSV_PROGRESS_ROWS) == 0)
+            {
+                task.Update(rowIndex);
+                if (task.IsCanceled())
+                    return;
+            }
+        }
+        if (!chunk.empty())
+            written = file.Write(chunk.data(), static_cast<uint32>(chunk.size()));
+    };
+    const auto completed = ProgressStatus::Run("Saving ...", rowsNo, write);
+    file.Close();
+    std::error_code err;
+    if ((!completed) || (!written))
+    {
+        std::filesystem::remove(tempPath, err);
+        CHECK(written, false, "Fail to write: %s", tempPath.string().c_str());
+        return false;
+    }
+    std::filesystem::rename(tempPath, path, err);
+    if (err)
+    {
+        std::filesystem::remove(tempPath, err);
+        RETURNERROR(false, "Fail to replace: %s", path.string().c_str());
+    }
+    return true;
+}
+} // namespace AppCUI
@@ -0,0 +1,540 @@
+#include "ControlContext.hpp"
+
+namespace AppCUI
+{
+constexpr uint32 HEXVIEW_MAX_PATTERN_SIZE = 0x1000;
+constexpr uint32 HEXVIEW_SEPARATOR_SIZE   = 2; // spaces between the offset and the hex column
+constexpr uint8 HEXVIEW_MARK_NONE         = 0;
+constexpr uint8 HEXVIEW_MARK_SEARCH       = 1;
+constexpr char HEX_DIGITS[]               = "0123456789ABCDEF";
+
+// the first byte of the pattern that is not a very common one (a better candidate for memchr)
+uint32 GetSearchAnchor(const std::vector<uint8>& pattern)
+{
+    for (uint32 idx = 0; idx < (uint32) pattern.size(); idx++)
+    {
+        if ((pattern[idx] != 0) && (pattern[idx] != 0xFF) && (pattern[idx] != ' '))
+            return idx;
+    }
+    return 0;
+}
+
+void HexViewControlContext::ComputeLineSize()
+{
+    const auto width   = (uint32) std::max<>(0, this->Layout.Width - 2);
+    this->OffsetDigits = this->Source.Size > 0xFFFFFFFFULL ? 16 : 8;
+    // bytes are displayed in groups of 8 (as many groups as the width permits)
+    this->BytesPerLine = 8;
+    while (GetAsciiColumn(this->BytesPerLine + 8) + this->BytesPerLine + 8 <= width)
+        this->BytesPerLine += 8;
+    while ((this->BytesPerLine > 1) && (GetAsciiColumn(this->BytesPerLine) + this->BytesPerLine > width))
+        this->BytesPerLine >>= 1;
+    this->TopOffset -= this->TopOffset % this->BytesPerLine;
+    MoveTo(this->CursorOffset);
+}
+uint32 HexViewControlContext::GetHexColumn(uint32 index) const
+{
+    return this->OffsetDigits + HEXVIEW_SEPARATOR_SIZE + index * 3 + (index >> 3);
+}
+uint32 HexViewControlContext::GetAsciiColumn(uint32 index) const
+{
+    // 'index' is the number of bytes on a line (the ASCII column starts after the last hex value)
+    return GetHexColumn(index) + 1;
+}
+uint32 HexViewControlContext::GetVisibleLines() const
+{
+    return (uint32) std::max<>(1, this->Layout.Height - 2);
+}
+void HexViewControlContext::MoveTo(uint64 offset)
+{
+    if (this->Source.Size == 0)
+    {
+        this->CursorOffset = 0;
+        this->TopOffset    = 0;
+        return;
+    }
+    offset             = std::min<>(offset, this->Source.Size - 1);
+    this->CursorOffset = offset;
+    const auto line    = offset - offset % this->BytesPerLine;
+    const auto viewSz  = (uint64) GetVisibleLines() * this->BytesPerLine;
+    if (line < this->TopOffset)
+        this->TopOffset = line;
+    else if (line >= this->TopOffset + viewSz)
+        this->TopOffset = line + this->BytesPerLine - viewSz;
+}
+bool HexViewControlContext::ReadBytes(uint64 offset, uint8* buffer, uint32 size)
+{
+    std::lock_guard<std::mutex> lock(this->Source.ObjectLock);
+    uint32 bytesRead = 0;
+    CHECK(this->Source.Object->Read(offset, buffer, size, bytesRead), false, "Fail to read %u bytes", size);
+    CHECK(bytesRead == size, false, "Only %u bytes (out of %u) were read", bytesRead, size);
+    return true;
+}
+const uint8* HexViewControlContext::GetVisibleBytes(uint64 offset, uint32 size)
+{
+    if (this->Source.File.GetData())
+        return this->Source.File.GetData() + offset;
+    CHECK(this->Source.Object, nullptr, "");
+    if ((this->View.Offset == offset) && (this->View.Buffer.size() == size))
+        return this->View.Buffer.data();
+    this->View.Buffer.resize(size);
+    if (!ReadBytes(offset, this->View.Buffer.data(), size))
+    {
+        this->View.Buffer.clear();
+        return nullptr;
+    }
+    this->View.Offset = offset;
+    return this->View.Buffer.data();
+}
+void HexViewControlContext::MarkSearchResults(uint64 start, uint32 size)
+{
+    this->Marks.assign(size, HEXVIEW_MARK_NONE);
+    const auto patternSize = (uint64) this->Search.Pattern.size();
+    if (patternSize == 0)
+        return;
+    const auto end = start + size;
+    std::lock_guard<std::mutex> lock(this->Search.ResultsLock);
+    // results are sorted --> only the ones that overlap the visible bytes are looked at
+    auto it = std::lower_bound(
+          this->Search.Results.begin(), this->Search.Results.end(), start > patternSize ? start - patternSize + 1 : 0);
+    for (; (it != this->Search.Results.end()) && ((*it) < end); it++)
+    {
+        const auto from = std::max<>(*it, start);
+        const auto to   = std::min<>((*it) + patternSize, end);
+        if (from < to)
+            memset(this->Marks.data() + (from - start), HEXVIEW_MARK_SEARCH, (size_t) (to - from));
+    }
+}
+void HexViewControlContext::Paint(Graphics::Renderer& renderer)
+{
+    const auto enabled = (this->Flags & GATTR_ENABLE) != 0;
+    const auto state   = this->GetControlState(ControlStateFlags::ProcessHoverStatus);
+    const auto colText = enabled ? this->Cfg->Text.Normal : this->Cfg->Text.Inactive;
+    const auto colGray = this->Cfg->Text.Inactive;
+    const auto colOfs  = this->Cfg->LineMarker.GetColor(this->GetControlState(ControlStateFlags::None));
+    const auto colCurs = this->Focused ? this->Cfg->Cursor.Normal : this->Cfg->Cursor.Inactive;
+    const auto colMark = this->Cfg->Selection.SearchMarker;
+
+    renderer.DrawRectSize(
+          0, 0, this->Layout.Width, this->Layout.Height, this->Cfg->Border.GetColor(state), LineType::Single);
+    if (this->Layout.Width <= 2)
+        return;
+    const auto width = (uint32) (this->Layout.Width - 2);
+    const auto lines = GetVisibleLines();
+    this->Line.resize(width);
+
+    // only the bytes of the visible lines are read
+    uint32 count = 0;
+    if (this->TopOffset < this->Source.Size)
+        count = (uint32) std::min<>(this->Source.Size - this->TopOffset, (uint64) lines * this->BytesPerLine);
+    const uint8* bytes = count > 0 ? GetVisibleBytes(this->TopOffset, count) : nullptr;
+    if (bytes == nullptr)
+        count = 0;
+    MarkSearchResults(this->TopOffset, count);
+
+    const auto asciiColumn = GetAsciiColumn(this->BytesPerLine);
+    for (uint32 y = 0; y < lines; y++)
+    {
+        for (auto& ch : this->Line)
+        {
+            ch.Code  = ' ';
+            ch.Color = colText;
+        }
+        const auto lineStart = y * this->BytesPerLine;
+        if (lineStart < count)
+        {
+            auto ofs = this->TopOffset + lineStart;
+            for (uint32 idx = this->OffsetDigits; idx > 0; idx--, ofs >>= 4)
+            {
+                if (idx <= width)
+                {
+                    this->Line[idx - 1].Code  = HEX_DIGITS[ofs & 0xF];
+                    this->Line[idx - 1].Color = colOfs;
+                }
+            }
+            const auto lineSize = std::min<>(this->BytesPerLine, count - lineStart);
+            for (uint32 idx = 0; idx < lineSize; idx++)
+            {
+                const auto value = bytes[lineStart + idx];
+                auto col         = ((value < 32) || (value > 126)) ? colGray : colText;
+                if (this->Marks[lineStart + idx] == HEXVIEW_MARK_SEARCH)
+                    col = colMark;
+                if (this->TopOffset + lineStart + idx == this->CursorOffset)
+                    col = colCurs;
+                const auto hx = GetHexColumn(idx);
+                if (hx + 1 < width)
+                {
+                    this->Line[hx].Code      = HEX_DIGITS[value >> 4];
+                    this->Line[hx].Color     = col;
+                    this->Line[hx + 1].Code  = HEX_DIGITS[value & 0xF];
+                    this->Line[hx + 1].Color = col;
+                }
+                const auto ax = asciiColumn + idx;
+                if (ax < width)
+                {
+                    this->Line[ax].Code  = ((value >= 32) && (value <= 126)) ? value : '.';
+                    this->Line[ax].Color = col;
+                }
+            }
+        }
+        renderer.WriteSingleLineCharacterBuffer(
+              1, (int) y + 1, CharacterView(this->Line.data(), this->Line.size()), true);
+    }
+}
+bool HexViewControlContext::OnKeyEvent(Input::Key keyCode)
+{
+    const auto viewSz = (uint64) GetVisibleLines() * this->BytesPerLine;
+    const auto column = this->CursorOffset % this->BytesPerLine;
+    switch (keyCode)
+    {
+    case Key::Up:
+        MoveTo(this->CursorOffset >= this->BytesPerLine ? this->CursorOffset - this->BytesPerLine : this->CursorOffset);
+        return true;
+    case Key::Down:
+        if (this->CursorOffset + this->BytesPerLine < this->Source.Size)
+            MoveTo(this->CursorOffset + this->BytesPerLine);
+        return true;
+    case Key::Left:
+        MoveTo(this->CursorOffset > 0 ? this->CursorOffset - 1 : 0);
+        return true;
+    case Key::Right:
+        MoveTo(this->CursorOffset + 1);
+        return true;
+    case Key::PageUp:
+        MoveTo(this->CursorOffset > viewSz ? this->CursorOffset - viewSz : column);
+        return true;
+    case Key::PageDown:
+        MoveTo(this->CursorOffset + viewSz);
+        return true;
+    case Key::Home:
+        MoveTo(this->CursorOffset - column);
+        return true;
+    case Key::End:
+        MoveTo(this->CursorOffset - column + this->BytesPerLine - 1);
+        return true;
+    case Key::Ctrl | Key::Home:
+        MoveTo(0);
+        return true;
+    case Key::Ctrl | Key::End:
+        MoveTo(this->Source.Size);
+        return true;
+    case Key::F3:
+        GoToSearchResult(true);
+        return true;
+    case Key::Shift | Key::F3:
+        GoToSearchResult(false);
+        return true;
+    }
+    return false;
+}
+void HexViewControlContext::OnMousePressed(int x, int y)
+{
+    if ((x < 1) || (y < 1) || (y > (int) GetVisibleLines()))
+        return;
+    const auto column    = (uint32) (x - 1);
+    const auto lineStart = this->TopOffset + (uint64) (y - 1) * this->BytesPerLine;
+    const auto ascii     = GetAsciiColumn(this->BytesPerLine);
+    for (uint32 idx = 0; idx < this->BytesPerLine; idx++)
+    {
+        const auto hx = GetHexColumn(idx);
+        if (((column >= hx) && (column < hx + 2)) || (column == ascii + idx))
+        {
+            if (lineStart + idx < this->Source.Size)
+                MoveTo(lineStart + idx);
+            return;
+        }
+    }
+}
+void HexViewControlContext::Close()
+{
+    StopSearch();
+    {
+        std::lock_guard<std::mutex> lock(this->Search.ResultsLock);
+        this->Search.Results.clear();
+    }
+    this->Search.Pattern.clear();
+    this->Search.ResultsCount        = 0;
+    this->Search.PaintedResultsCount = 0;
+    this->Search.SearchedBytes       = 0;
+    this->Source.File.Close();
+    if (this->Source.Object)
+    {
+        this->Source.Object->Close();
+        this->Source.Object.reset();
+    }
+    this->Source.Size = 0;
+    this->View.Buffer.clear();
+    this->View.Offset  = 0;
+    this->TopOffset    = 0;
+    this->CursorOffset = 0;
+    ComputeLineSize();
+}
+bool HexViewControlContext::StartSearch(Utils::BufferView pattern)
+{
+    StopSearch();
+    CHECK(pattern.GetLength() > 0, false, "Empty search pattern !");
+    CHECK(pattern.GetLength() <= HEXVIEW_MAX_PATTERN_SIZE,
+          false,
+          "Search pattern is too large (%u bytes, max allowed is %u bytes)",
+          (uint32) pattern.GetLength(),
+          HEXVIEW_MAX_PATTERN_SIZE);
+    CHECK(this->Source.File.GetData() || this->Source.Object, false, "Nothing to search (no file/object was opened)");
+    {
+        std::lock_guard<std::mutex> lock(this->Search.ResultsLock);
+        this->Search.Results.clear();
+    }
+    this->Search.Pattern.assign(pattern.GetData(), pattern.GetData() + pattern.GetLength());
+    this->Search.ResultsCount        = 0;
+    this->Search.PaintedResultsCount = 0;
+    this->Search.SearchedBytes       = 0;
+    this->Search.Stop                = false;
+    this->Search.Running             = true;
+    // the search can take a long time (large files) --> it does not use one of the shared worker threads
+    this->Search.Worker = Internal::RunLongTask([this]() { SearchWorker(); });
+    if (!this->Search.Worker.valid())
+        this->Search.Running = false;
+    return this->Search.Worker.valid();
+}
+void HexViewControlContext::StopSearch()
+{
+    this->Search.Stop = true;
+    if (this->Search.Worker.valid())
+    {
+        this->Search.Worker.wait();
+        this->Search.Worker = std::future<void>();
+    }
+    this->Search.Running = false;
+}
+void HexViewControlContext::SearchWorker()
+{
+    const auto* pattern    = this->Search.Pattern.data();
+    const auto patternSize = (uint32) this->Search.Pattern.size();
+    const auto anchor      = GetSearchAnchor(this->Search.Pattern);
+    const auto anchorValue = pattern[anchor];
+    const auto size        = this->Source.Size;
+    std::vector<uint8> chunk;
+    std::vector<uint64> found;
+
+    for (uint64 pos = 0; (pos + patternSize <= size) && (!this->Search.Stop); pos += HEXVIEW_SEARCH_CHUNK_SIZE)
+    {
+        // consecutive chunks overlap with (patternSize-1) bytes so that no match is lost at their boundary
+        const auto chunkSize = (uint32) std::min<>((uint64) HEXVIEW_SEARCH_CHUNK_SIZE + patternSize - 1, size - pos);
+        const uint8* data    = nullptr;
+        if (this->Source.File.GetData())
+        {
+            data = this->Source.File.GetData() + pos;
+        }
+        else
+        {
+            chunk.resize(chunkSize);
+            if (!ReadBytes(pos, chunk.data(), chunkSize))
+                break;
+            data = chunk.data();
+        }
+        // memchr (vectorized by the C runtime) finds the candidates, memcmp validates them
+        found.clear();
+        const auto* p   = data + anchor;
+        const auto* end = data + chunkSize - (patternSize - 1) + anchor;
+        while (p < end)
+        {
+            p = reinterpret_cast<const uint8*>(memchr(p, anchorValue, (size_t) (end - p)));
+            if (!p)
+                break;
+            if (memcmp(p - anchor, pattern, patternSize) == 0)
+                found.push_back(pos + (uint64) (p - anchor - data));
+            p++;
+        }
+
+        bool full = false;
+        if (!found.empty())
+        {
+            std::lock_guard<std::mutex> lock(this->Search.ResultsLock);
+            const auto room =
+                  HEXVIEW_MAX_SEARCH_RESULTS - std::min<size_t>(this->Search.Results.size(), HEXVIEW_MAX_SEARCH_RESULTS);
+            this->Search.Results.insert(
+                  this->Search.Results.end(), found.begin(), found.begin() + std::min<size_t>(room, found.size()));
+            full                      = this->Search.Results.size() >= HEXVIEW_MAX_SEARCH_RESULTS;
+            this->Search.ResultsCount = this->Search.Results.size();
+        }
+        this->Search.SearchedBytes = std::min<>(pos + HEXVIEW_SEARCH_CHUNK_SIZE, size);
+        if (full)
+            break;
+    }
+    this->Search.Running = false;
+}
+bool HexViewControlContext::GoToSearchResult(bool next)
+{
+    uint64 offset;
+    {
+        std::lock_guard<std::mutex> lock(this->Search.ResultsLock);
+        const auto& r = this->Search.Results;
+        if (next)
+        {
+            auto it = std::upper_bound(r.begin(), r.end(), this->CursorOffset);
+            if (it == r.end())
+                return false;
+            offset = *it;
+        }
+        else
+        {
+            auto it = std::lower_bound(r.begin(), r.end(), this->CursorOffset);
+            if (it == r.begin())
+                return false;
+            offset = *(it - 1);
+        }
+    }
+    MoveTo(offset);
+    return true;
+}
+
+HexView::HexView(string_view layout) : Control(new HexViewControlContext(), "", layout, false)
+{
+    auto Members                        = reinterpret_cast<HexViewControlContext*>(this->Context);
+    Members->Layout.MinWidth            = 20;
+    Members->Layout.MinHeight           = 3;
+    Members->Flags                      = GATTR_ENABLE | GATTR_VISIBLE | GATTR_TABSTOP | GATTR_VSCROLL;
+    Members->Source.Size                = 0;
+    Members->View.Offset                = 0;
+    Members->Search.Stop                = false;
+    Members->Search.Running             = false;
+    Members->Search.SearchedBytes       = 0;
+    Members->Search.ResultsCount        = 0;
+    Members->Search.PaintedResultsCount = 0;
+    Members->TopOffset                  = 0;
+    Members->CursorOffset               = 0;
+    Members->BytesPerLine               = 8;
+    Members->OffsetDigits               = 8;
+    Members->ComputeLineSize();
+}
+HexView::~HexView()
+{
+    reinterpret_cast<HexViewControlContext*>(this->Context)->Close();
+    DELETE_CONTROL_CONTEXT(HexViewControlContext);
+}
+bool HexView::OpenFile(const std::filesystem::path& filePath)
+{
+    CREATE_TYPECONTROL_CONTEXT(HexViewControlContext, Members, false);
+    Members->Close();
+    CHECK(Members->Source.File.OpenRead(filePath), false, "Fail to open: %s", filePath.string().c_str());
+    Members->Source.Size = Members->Source.File.GetSize();
+    Members->ComputeLineSize();
+    return true;
+}
+bool HexView::Open(std::unique_ptr<OS::DataObject> dataObject)
+{
+    CREATE_TYPECONTROL_CONTEXT(HexViewControlContext, Members, false);
+    CHECK(dataObject, false, "Expecting a valid data object !");
+    Members->Close();
+    Members->Source.Size   = dataObject->GetSize();
+    Members->Source.Object = std::move(dataObject);
+    Members->ComputeLineSize();
+    return true;
+}
+void HexView::Close()
+{
+    reinterpret_cast<HexViewControlContext*>(this->Context)->Close();
+}
+uint64 HexView::GetSize() const
+{
+    return reinterpret_cast<HexViewControlContext*>(this->Context)->Source.Size;
+}
+uint64 HexView::GetCursorOffset() const
+{
+    return reinterpret_cast<HexViewControlContext*>(this->Context)->CursorOffset;
+}
+bool HexView::GoTo(uint64 offset)
+{
+    CREATE_TYPECONTROL_CONTEXT(HexViewControlContext, Members, false);
+    CHECK(offset < Members->Source.Size,
+          false,
+          "Invalid offset: %llu (size is %llu)",
+          (unsigned long long) offset,
+          (unsigned long long) Members->Source.Size);
+    Members->MoveTo(offset);
+    return true;
+}
+bool HexView::Search(Utils::BufferView pattern)
+{
+    CHECK(reinterpret_cast<HexViewControlContext*>(this->Context)->StartSearch(pattern), false, "");
+    EnableFrameUpdates(); // results are painted while the search runs
+    return true;
+}
+void HexView::StopSearch()
+{
+    reinterpret_cast<HexViewControlContext*>(this->Context)->StopSearch();
+    DisableFrameUpdates();
+}
+bool HexView::IsSearching() const
+{
+    return reinterpret_cast<HexViewControlContext*>(this->Context)->Search.Running;
+}
+uint64 HexView::GetSearchedBytes() const
+{
+    return reinterpret_cast<HexViewControlContext*>(this->Context)->Search.SearchedBytes;
+}
+uint64 HexView::GetSearchResultsCount() const
+{
+    return reinterpret_cast<HexViewControlContext*>(this->Context)->Search.ResultsCount;
+}
+bool HexView::GoToNextSearchResult()
+{
+    return reinterpret_cast<HexViewControlContext*>(this->Context)->GoToSearchResult(true);
+}
+bool HexView::GoToPreviousSearchResult()
+{
+    return reinterpret_cast<HexViewControlContext*>(this->Context)->GoToSearchResult(false);
+}
+void HexView::Paint(Graphics::Renderer& renderer)
+{
+    reinterpret_cast<HexViewControlContext*>(this->Context)->Paint(renderer);
+}
+bool HexView::OnKeyEvent(Input::Key keyCode, char16 /*UnicodeChar*/)
+{
+    return reinterpret_cast<HexViewControlContext*>(this->Context)->OnKeyEvent(keyCode);
+}
+void HexView::OnMousePressed(int x, int y, Input::MouseButton /*button*/, Input::Key)
+{
+    reinterpret_cast<HexViewControlContext*>(this->Context)->OnMousePressed(x, y);
+}
+bool HexView::OnMouseWheel(int /*x*/, int /*y*/, Input::MouseWheel direction, Input::Key)
+{
+    switch (direction)
+    {
+    case MouseWheel::Up:
+        return OnKeyEvent(Key::Up, 0);
+    case MouseWheel::Down:
+        return OnKeyEvent(Key::Down, 0);
+    }
+    return false;
+}
+bool HexView::OnFrameUpdate()
+{
+    // new search results are painted as they are found
+    auto Members        = reinterpret_cast<HexViewControlContext*>(this->Context);
+    const auto results  = Members->Search.ResultsCount.load();
+    const auto finished = (!Members->Search.Running) && (Members->Search.Worker.valid());
+    if ((results == Members->Search.PaintedResultsCount) && (!finished))
+    {
+        if (!Members->Search.Running)
+            DisableFrameUpdates(); // the search was stopped (a new file was opened)
+        return false;
+    }
+    Members->Search.PaintedResultsCount = results;
+    if (finished)
+    {
+        Members->Search.Worker.wait(); // the search has finished (the task only has to return)
+        Members->Search.Worker = std::future<void>();
+        DisableFrameUpdates();
+    }
+    return true;
+}
+void HexView::OnAfterResize(int /*newWidth*/, int /*newHeight*/)
+{
+    reinterpret_cast<HexViewControlContext*>(this->Context)->ComputeLineSize();
+}
+void HexView::OnUpdateScrollBars()
+{
+    auto Members = reinterpret_cast<HexViewControlContext*>(this->Context);
+    UpdateVScrollBar(Members->CursorOffset, Members->Source.Size > 0 ? Members->Source.Size - 1 : 0);
+}
+} // namespace AppCUI
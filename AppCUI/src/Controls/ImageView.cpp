@@ -1,21 +1,137 @@
 #include "ControlContext.hpp"
+#include "Graphics/ImageLoader.hpp"
 
-namespace AppCUI::Controls
+namespace AppCUI
 {
+uint64 ComputeImageHash(const Graphics::Image& img)
+{
+    // FNV-1a over the pixels (32 bits at a time)
+    uint64 hash      = 0xcbf29ce484222325ULL;
+    const auto* p    = img.GetPixelsBuffer();
+    const auto count = (size_t) img.GetWidth() * (size_t) img.GetHeight();
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        hash ^= p[idx].ColorValue;
+        hash *= 0x00000100000001B3ULL;
+    }
+    return hash;
+}
+// the finer pyramid level a level is reduced from (it must divide the factor)
+uint32 GetParentScaleFactor(uint32 factor)
+{
+    switch (factor)
+    {
+    case 4:
+        return 2;
+    case 10:
+        return 5;
+    case 20:
+        return 10;
+    default:
+        return 1;
+    }
+}
+
+void ImageViewControlContext::SetSource(const Graphics::Image& img)
+{
+    const auto hash = ComputeImageHash(img);
+    if ((Source.Hash == hash) && (Source.Width == img.GetWidth()) && (Source.Height == img.GetHeight()))
+        return; // same image --> everything that was computed is still valid
+    Source.Hash   = hash;
+    Source.Width  = img.GetWidth();
+    Source.Height = img.GetHeight();
+    ReleaseScaledImages();
+    RenderedImages.clear();
+}
+void ImageViewControlContext::ReleaseScaledImages()
+{
+    for (auto& level : ScaledImages)
+        level = Graphics::Image();
+}
+const Graphics::Image* ImageViewControlContext::GetScaledImage(const Graphics::Image& img, uint32 factor)
+{
+    CHECK((factor >= 1) && (factor <= IMAGEVIEW_MAX_SCALE_FACTOR), nullptr, "Invalid scale factor: %u", factor);
+    if (factor == 1)
+        return &img;
+    auto& level = ScaledImages[factor];
+    if (level.GetPixelsBuffer())
+        return &level;
+    // zooming out reuses the coarser levels that were already computed
+    const auto parentFactor = GetParentScaleFactor(factor);
+    auto parent             = GetScaledImage(img, parentFactor);
+    CHECK(parent, nullptr, "");
+    Graphics::ImageDownscaler downscaler(level);
+    CHECK(downscaler.Create(parent->GetWidth(), parent->GetHeight(), factor / parentFactor), nullptr, "");
+    const auto* row = parent->GetPixelsBuffer();
+    for (uint32 y = 0; y < parent->GetHeight(); y++, row += parent->GetWidth())
+        downscaler.AddRow(row);
+    return &level;
+}
+const Graphics::Canvas* ImageViewControlContext::GetRenderedImage(
+      const Graphics::Image& img, Graphics::ImageRenderingMethod method, Graphics::ImageScaleMethod scale)
+{
+    SetSource(img);
+    for (auto it = RenderedImages.begin(); it != RenderedImages.end(); it++)
+    {
+        if ((it->Method == method) && (it->Scale == scale))
+        {
+            // move it to the front (most recently used)
+            std::rotate(RenderedImages.begin(), it, it + 1);
+            return RenderedImages.front().Cells.get();
+        }
+    }
+    auto scaledImage = GetScaledImage(img, static_cast<uint32>(scale));
+    CHECK(scaledImage, nullptr, "Fail to scale the image");
+
+    auto cells = std::make_unique<Graphics::Canvas>();
+    auto sz    = cells->ComputeRenderingSize(img, method, scale);
+    CHECK((sz.Width > 0) && (sz.Height > 0), nullptr, "Invalid image size (0x0) --> nothing to render");
+    CHECK(cells->Create(sz.Width, sz.Height), nullptr, "Fail to create a %ux%u canvas", sz.Width, sz.Height);
+    CHECK(cells->DrawImage(*scaledImage, 0, 0, method, Graphics::ImageScaleMethod::NoScale), nullptr, "");
+
+    if (RenderedImages.size() >= IMAGEVIEW_MAX_RENDERED_CACHE)
+        RenderedImages.pop_back();
+    RenderedImages.insert(RenderedImages.begin(), RenderedImage{ method, scale, std::move(cells) });
+    return RenderedImages.front().Cells.get();
+}
+
 ImageView::ImageView(const ConstString& caption, string_view layout, ViewerFlags flags)
-    : CanvasViewer(caption, layout, 16, 16, flags)
+    : CanvasViewer(new ImageViewControlContext(), caption, layout, 16, 16, flags)
 {
+    auto Members           = reinterpret_cast<ImageViewControlContext*>(this->Context);
+    Members->Source.Hash   = 0;
+    Members->Source.Width  = 0;
+    Members->Source.Height = 0;
+}
+ImageView::~ImageView()
+{
+    DELETE_CONTROL_CONTEXT(ImageViewControlContext);
 }
 bool ImageView::SetImage(
       const Graphics::Image& img, Graphics::ImageRenderingMethod method, Graphics::ImageScaleMethod scale)
 {
     auto c = GetCanvas();
     CHECK(c.IsValid(), false, "");
-    auto sz = c->ComputeRenderingSize(img, method, scale);
-    CHECK((sz.Width > 0) && (sz.Height > 0), false, "Invalid image size (0x0) --> nothing to render");
-    CHECK(c->Resize(sz.Width, sz.Height), false, "Fail to set canvas size to %ux%u", sz.Width, sz.Height);
-    CREATE_TYPECONTROL_CONTEXT(CanvasControlContext, Members, false);
+    CREATE_TYPECONTROL_CONTEXT(ImageViewControlContext, Members, false);
+    auto cells = Members->GetRenderedImage(img, method, scale);
+    // the view does not own the image --> the reduced copies are not kept after the image was converted
+    Members->ReleaseScaledImages();
+    CHECK(cells, false, "Fail to convert the image into characters");
+    CHECK(c->Resize(cells->GetWidth(), cells->GetHeight()),
+          false,
+          "Fail to set canvas size to %ux%u",
+          cells->GetWidth(),
+          cells->GetHeight());
     Members->MoveScrollTo(0, 0);
-    return c->DrawImage(img, 0, 0, method, scale);
+    return c->DrawCanvas(0, 0, *cells, NoColorPair);
+}
+bool ImageView::SetImage(
+      const std::filesystem::path& imageFilePath,
+      Graphics::ImageRenderingMethod method,
+      Graphics::ImageScaleMethod scale)
+{
+    Graphics::Image img;
+    CHECK(img.Load(imageFilePath, scale), false, "Fail to load image: %s", imageFilePath.string().c_str());
+    return SetImage(img, method, Graphics::ImageScaleMethod::NoScale);
 }
-} // namespace AppCUI::Controls
\ No newline at end of file
+} // namespace AppCUI
@@ -1,10 +1,13 @@
 #include "ControlContext.hpp"
+#include <bit>
+#include <cmath>
 
 namespace AppCUI
 {
 constexpr uint32 ITEM_FLAG_CHECKED         = 0x0001;
 constexpr uint32 ITEM_FLAG_SELECTED        = 0x0002;
 constexpr uint32 LISTVIEW_SEARCH_BAR_WIDTH = 12;
+constexpr uint32 LISTVIEW_INVALID_POSITION = 0xFFFFFFFF;
 
 #define PREPARE_LISTVIEW_ITEM(index, returnValue)                                                                      \
     CHECK(index < Items.List.size(), returnValue, "Invalid index: %d", index);                                         \
@@ -50,7 +53,7 @@ InternalListViewItem::InternalListViewItem(InternalListViewItem&& obj) noexcept
     this->XOffset   = obj.XOffset;
     for (uint32 tr = 0; tr < MAX_LISTVIEW_COLUMNS; tr++)
     {
-        this->SubItem[tr]         = obj.SubItem[tr];
+        this->SubItem[tr].Swap(obj.SubItem[tr]);
         this->subItemsColored[tr] = obj.subItemsColored[tr];
         this->subItemsColor[tr]   = obj.subItemsColor[tr];
     }
@@ -68,9 +71,9 @@ void ListViewControlContext::DrawItem(Graphics::Renderer& renderer, InternalList
 {
     int x = this->Header[0].x;
     int itemStart;
-    auto columnsCount        = Header.GetColumnsCount();
-    CharacterBuffer* subitem = item->SubItem;
-    ColorPair itemCol        = Cfg->Text.Normal;
+    auto columnsCount       = Header.GetColumnsCount();
+    const ItemHandle handle = (ItemHandle) (item - Items.List.data());
+    ColorPair itemCol       = Cfg->Text.Normal;
     ColorPair checkCol, uncheckCol;
     WriteTextParams params(WriteTextFlags::SingleLine | WriteTextFlags::OverwriteColors | WriteTextFlags::ClipToWidth);
     params.Y = y;
@@ -123,20 +126,45 @@ void ListViewControlContext::DrawItem(Graphics::Renderer& renderer, InternalList
     }
 
     // disable is not active
+    uint32 searchColumn = 0;
+    int32 searchIndex   = -1; // position of the search text in the searchColumn cell
     if (!(Flags & GATTR_ENABLE))
         itemCol = Cfg->Text.Inactive;
     else
     {
         // if activ and filtered
-        if ((this->Filter.filterMode == ListViewFilterMode::CustomHighlight) || (this->Filter.SearchText.Len() > 0))
+        if (this->Filter.filterMode == ListViewFilterMode::CustomHighlight)
         {
             params.Flags =
                   static_cast<WriteTextFlags>((uint32) params.Flags - (uint32) WriteTextFlags::OverwriteColors);
         }
+        else if (this->Filter.SearchText.Len() > 0)
+        {
+            // the search text is only looked for in the items that are painted
+            itemCol     = Cfg->Text.Inactive;
+            searchIndex = FindSearchText(handle, searchColumn);
+        }
     }
     // prepare params
     params.Color = itemCol;
 
+    auto writeCellText = [&](uint32 columnIndex)
+    {
+        if ((searchIndex < 0) || (columnIndex != searchColumn))
+        {
+            renderer.WriteText(GetCellText(handle, columnIndex), params);
+            return;
+        }
+        // the item keeps its colors --> the match is colored in a copy of the cell
+        SearchCell.Set(GetCellText(handle, columnIndex));
+        SearchCell.SetColor(params.Color);
+        SearchCell.SetColor(searchIndex, searchIndex + Filter.SearchText.Len(), Cfg->Selection.SearchMarker);
+        const auto flags = params.Flags;
+        params.Flags     = static_cast<WriteTextFlags>((uint32) flags & (~((uint32) WriteTextFlags::OverwriteColors)));
+        renderer.WriteText(SearchCell, params);
+        params.Flags = flags;
+    };
+
     // for chategory items a special draw is made (only first comlumn is shown)
     if (item->Type == ListViewItem::Type::Category)
     {
@@ -150,7 +178,7 @@ void ListViewControlContext::DrawItem(Graphics::Renderer& renderer, InternalList
         params.Flags |= WriteTextFlags::LeftMargin | WriteTextFlags::RightMargin;
         if (currentItem)
             params.Color = Cfg->Cursor.Normal;
-        renderer.WriteText(*subitem, params);
+        writeCellText(0);
         return;
     }
 
@@ -158,7 +186,7 @@ void ListViewControlContext::DrawItem(Graphics::Renderer& renderer, InternalList
     {
         params.Flags = WriteTextFlags::MultipleLines | WriteTextFlags::OverwriteColors |
                        WriteTextFlags::FitTextToWidth | WriteTextFlags::ClipToWidth;
-        if ((this->Filter.filterMode == ListViewFilterMode::CustomHighlight) || (this->Filter.SearchText.Len() > 0))
+        if (this->Filter.filterMode == ListViewFilterMode::CustomHighlight)
         {
             params.Flags =
                   static_cast<WriteTextFlags>((uint32) params.Flags - (uint32) WriteTextFlags::OverwriteColors);
@@ -188,24 +216,22 @@ void ListViewControlContext::DrawItem(Graphics::Renderer& renderer, InternalList
         params.X     = x;
         params.Align = firstColumn.align;
 
-        const auto tr = (subitem - item->SubItem) / sizeof(CharacterBuffer);
-        if (item->Type == ListViewItem::Type::SubItemColored && item->subItemsColored[tr] == true &&
+        if (item->Type == ListViewItem::Type::SubItemColored && item->subItemsColored[0] == true &&
             (this->Filter.filterMode == ListViewFilterMode::None || this->Filter.SearchText.Len() == 0))
         {
             const auto previousColor = params.Color;
-            params.Color             = item->subItemsColor[tr];
-            renderer.WriteText(*subitem, params);
+            params.Color             = item->subItemsColor[0];
+            renderer.WriteText(GetCellText(handle, 0), params);
             params.Color = previousColor;
         }
         else
         {
-            renderer.WriteText(*subitem, params);
+            writeCellText(0);
         }
     }
     // rest of the columns
     itemStart = x;
     x         = end_first_column + 1;
-    subitem++;
 
     for (uint32 tr = 1; (tr < columnsCount) && (x < (int) this->Layout.Width); tr++)
     {
@@ -221,15 +247,14 @@ void ListViewControlContext::DrawItem(Graphics::Renderer& renderer, InternalList
             {
                 const auto previousColor = params.Color;
                 params.Color             = item->subItemsColor[tr];
-                renderer.WriteText(*subitem, params);
+                renderer.WriteText(GetCellText(handle, tr), params);
                 params.Color = previousColor;
             }
             else
             {
-                renderer.WriteText(*subitem, params);
+                writeCellText(tr);
             }
         }
-        subitem++;
     }
     // set the viewing clip
     if (((((uint32) Flags) & ((uint32) ListViewFlags::HideBorder)) == 0))
@@ -390,11 +415,43 @@ void ListViewControlContext::Paint(Graphics::Renderer& renderer)
 ItemHandle ListViewControlContext::AddItem(const ConstString& text)
 {
     ItemHandle idx = (uint32) Items.List.size();
-    Items.List.push_back(InternalListViewItem(Cfg->Text.Normal));
+    Items.List.emplace_back(Cfg->Text.Normal);
     Items.Indexes.Push(idx);
+    if (Items.LinesValid)
+    {
+        Items.Positions.push_back(Items.Lines.Len());
+        Items.Lines.Push((Flags && ListViewFlags::ItemSeparators) ? 2 : 1);
+    }
     SetItemText(idx, 0, text);
     return idx;
 }
+uint32 ListViewControlContext::AddItems(uint32 count, const ItemsGenerator& getItem)
+{
+    CHECK(getItem, 0, "Expecting a valid items generator !");
+    const auto start        = (uint32) Items.List.size();
+    const auto columnsCount = std::min<>(Header.GetColumnsCount(), MAX_LISTVIEW_COLUMNS);
+    const auto color        = (Filter.filterMode != ListViewFilterMode::None) ? Cfg->Text.Inactive : NoColorPair;
+    // storage is allocated once for the entire batch
+    Items.List.reserve((size_t) start + count);
+    CHECK(Items.Indexes.Reserve(start + count), 0, "Fail to allocate %u indexes", start + count);
+
+    vector<string_view> texts;
+    texts.reserve(columnsCount);
+    uint32 added = 0;
+    while ((added < count) && (getItem(added, texts)))
+    {
+        auto& item    = Items.List.emplace_back(Cfg->Text.Normal);
+        const auto sz = std::min<size_t>(texts.size(), columnsCount);
+        for (size_t tr = 0; tr < sz; tr++)
+            item.SubItem[tr].Set(u8string_view((const char8*) texts[tr].data(), texts[tr].size()), color);
+        AddToSearchIndex(start + added);
+        Items.Indexes.Push(start + added);
+        texts.clear();
+        added++;
+    }
+    Items.LinesValid = false; // rebuilt at once (if needed) for the entire batch
+    return added;
+}
 bool ListViewControlContext::SetItemText(ItemHandle item, uint32 subItem, const ConstString& text)
 {
     PREPARE_LISTVIEW_ITEM(item, false);
@@ -404,21 +461,165 @@ bool ListViewControlContext::SetItemText(ItemHandle item, uint32 subItem, const
           subItem,
           Header.GetColumnsCount());
     CHECK(subItem < MAX_LISTVIEW_COLUMNS, false, "Subitem must be smaller than 64");
-    CHECK(i.SubItem[subItem].Set(text), false, "Fail to set text to a sub-item: %s", text);
+    RemoveFromSearchIndex(item);
+    const auto result = i.SubItem[subItem].Set(text);
+    AddToSearchIndex(item);
+    CHECK(result, false, "Fail to set text to a sub-item: %s", text);
+    this->Filter.CanRefine = false; // the item might match a text that it did not match before
     if (this->Filter.filterMode != ListViewFilterMode::None)
         i.SubItem[subItem].SetColor(this->Cfg->Text.Inactive);
     return true;
 }
-Graphics::CharacterBuffer* ListViewControlContext::GetItemText(ItemHandle item, uint32 subItem)
+const Graphics::CharacterBuffer* ListViewControlContext::GetItemText(ItemHandle item, uint32 subItem)
 {
-    PREPARE_LISTVIEW_ITEM(item, nullptr);
+    CHECK(item < Items.List.size(), nullptr, "Invalid index: %d", item);
     CHECK(subItem < Header.GetColumnsCount(),
           nullptr,
           "Invalid column index (%d), should be smaller than %d",
           subItem,
           Header.GetColumnsCount());
     CHECK(subItem < MAX_LISTVIEW_COLUMNS, nullptr, "Subitem must be smaller than 64");
-    return &i.SubItem[subItem];
+    return &Items.List[item].SubItem[subItem];
+}
+bool ListViewControlContext::GetItemFormattedText(ItemHandle item, uint32 subItem, CharacterBuffer& text)
+{
+    CHECK(item < Items.List.size(), false, "Invalid index: %d", item);
+    CHECK(subItem < std::min<>(Header.GetColumnsCount(), MAX_LISTVIEW_COLUMNS),
+          false,
+          "Invalid column index (%d), should be smaller than %d",
+          subItem,
+          Header.GetColumnsCount());
+    // the formatted cell is a shared buffer --> the caller gets its own copy
+    CHECK(text.Set(GetCellText(item, subItem)), false, "Fail to copy the text of sub-item %d", subItem);
+    return true;
+}
+// typed columns
+static string_view FormatDoubleValue(double value, NumericFormat fmt, NumericFormatter& n, LocalString<96>& temp)
+{
+    // the integer part is grouped (if requested) and 3 decimals are always shown
+    if ((fmt.GroupSize == 0) || (!std::isfinite(value)) || (std::fabs(value) >= 9.0e15))
+        return n.ToDec(value);
+    const auto scaled   = std::llabs(std::llround(value * 1000.0));
+    fmt.Base            = 10;
+    const auto intPart  = n.ToString((uint64) (scaled / 1000), fmt);
+    const auto fraction = (uint32) (scaled % 1000);
+    return temp.Format(
+          "%s%.*s.%03u", (value < 0) && (scaled > 0) ? "-" : "", (int) intPart.size(), intPart.data(), fraction);
+}
+bool ListViewControlContext::SetColumnType(uint32 columnIndex, ListViewColumnType type, NumericFormat format)
+{
+    CHECK(columnIndex < std::min<>(Header.GetColumnsCount(), MAX_LISTVIEW_COLUMNS),
+          false,
+          "Invalid column index (%d), should be smaller than %d",
+          columnIndex,
+          Header.GetColumnsCount());
+    if (columnIndex >= TypedColumns.size())
+        TypedColumns.resize((size_t) columnIndex + 1);
+    auto& col  = TypedColumns[columnIndex];
+    col.Type   = type;
+    col.Format = format;
+    // values stored with the previous type can not be reinterpreted
+    col.Values.clear();
+    col.HasValue.clear();
+    this->Filter.CanRefine = false;
+    return true;
+}
+template <typename T>
+bool ListViewControlContext::SetItemValue(ItemHandle item, uint32 subItem, T value)
+{
+    CHECK(item < Items.List.size(), false, "Invalid index: %d", item);
+    CHECK((subItem < TypedColumns.size()) && (TypedColumns[subItem].Type != ListViewColumnType::Text),
+          false,
+          "Column %d does not have a type (use SetColumnType first)",
+          subItem);
+    auto& col = TypedColumns[subItem];
+    if (item >= col.Values.size())
+    {
+        col.Values.resize(Items.List.size(), 0);
+        col.HasValue.resize(Items.List.size(), false);
+    }
+    switch (col.Type)
+    {
+    case ListViewColumnType::Int64:
+        col.Values[item] = std::bit_cast<uint64>(static_cast<int64>(value));
+        break;
+    case ListViewColumnType::Double:
+        col.Values[item] = std::bit_cast<uint64>(static_cast<double>(value));
+        break;
+    default:
+        col.Values[item] = static_cast<uint64>(value);
+        break;
+    }
+    col.HasValue[item]     = true;
+    this->Filter.CanRefine = false;
+    return true;
+}
+bool ListViewControlContext::HasItemValue(ItemHandle item, uint32 subItem) const
+{
+    return (subItem < TypedColumns.size()) && (item < TypedColumns[subItem].HasValue.size()) &&
+           (TypedColumns[subItem].HasValue[item]);
+}
+uint64 ListViewControlContext::GetItemSortKey(ItemHandle item, uint32 subItem) const
+{
+    // keys that keep the order of the values when compared as unsigned integers
+    const auto& col = TypedColumns[subItem];
+    const auto raw  = col.Values[item];
+    switch (col.Type)
+    {
+    case ListViewColumnType::Int64:
+        return raw ^ 0x8000000000000000ULL;
+    case ListViewColumnType::Double:
+        return (raw & 0x8000000000000000ULL) ? ~raw : raw | 0x8000000000000000ULL;
+    default:
+        return raw;
+    }
+}
+CharacterBuffer& ListViewControlContext::GetCellText(ItemHandle item, uint32 subItem)
+{
+    if (!HasItemValue(item, subItem))
+        return Items.List[item].SubItem[subItem];
+    // typed values are formatted only when they are needed (painted, searched or copied)
+    const auto& col = TypedColumns[subItem];
+    const auto raw  = col.Values[item];
+    NumericFormatter n;
+    LocalString<96> temp;
+    OS::DateTime dt;
+    string_view text;
+    switch (col.Type)
+    {
+    case ListViewColumnType::Int64:
+        text = n.ToString(std::bit_cast<int64>(raw), col.Format);
+        break;
+    case ListViewColumnType::UInt64:
+        text = n.ToString(raw, col.Format);
+        break;
+    case ListViewColumnType::Double:
+        text = FormatDoubleValue(std::bit_cast<double>(raw), col.Format, n, temp);
+        break;
+    case ListViewColumnType::DateTime:
+        if (dt.CreateFromTimestamp(raw))
+            text = dt.GetStringRepresentation();
+        break;
+    default:
+        break;
+    }
+    FormattedCell.Set(text, (Filter.filterMode != ListViewFilterMode::None) ? Cfg->Text.Inactive : NoColorPair);
+    return FormattedCell;
+}
+int32 ListViewControlContext::CompareItems(ItemHandle item1, ItemHandle item2, uint32 subItem) const
+{
+    const auto typed1 = HasItemValue(item1, subItem);
+    const auto typed2 = HasItemValue(item2, subItem);
+    if ((typed1) && (typed2))
+    {
+        const auto k1 = GetItemSortKey(item1, subItem);
+        const auto k2 = GetItemSortKey(item2, subItem);
+        return k1 < k2 ? -1 : (k1 > k2 ? 1 : 0);
+    }
+    // cells that only have a text are placed before the ones with a value
+    if (typed1 != typed2)
+        return typed1 ? 1 : -1;
+    return Items.List[item1].SubItem[subItem].CompareWith(Items.List[item2].SubItem[subItem], true);
 }
 bool ListViewControlContext::SetItemCheck(ItemHandle item, bool check)
 {
@@ -523,6 +724,12 @@ bool ListViewControlContext::SetItemHeight(ItemHandle item, uint32 itemHeight)
 {
     CHECK(itemHeight > 0, false, "Item height should be bigger than 0");
     PREPARE_LISTVIEW_ITEM(item, false);
+    if (itemHeight > 1)
+        Items.TallItems += (i.Height > 1) ? 0 : 1;
+    else
+        Items.TallItems -= (i.Height > 1) ? 1 : 0;
+    if ((Items.LinesValid) && (Items.Positions[item] != LISTVIEW_INVALID_POSITION))
+        Items.Lines.Add(Items.Positions[item], static_cast<int32>(itemHeight) - static_cast<int32>(i.Height));
     i.Height = itemHeight;
     return true;
 }
@@ -635,32 +842,77 @@ void ListViewControlContext::DeleteAllItems()
 {
     Items.List.clear();
     Items.Indexes.Clear();
+    Items.Lines.Clear();
+    Items.Positions.clear();
+    Items.TallItems  = 0;
+    Items.LinesValid = false;
+    SearchIndex.Clear();
+    for (auto& col : TypedColumns)
+    {
+        col.Values.clear();
+        col.HasValue.clear();
+    }
     Items.FirstVisibleIndex = 0;
     Items.CurentItemIndex   = 0;
     Filter.filterMode       = ListViewFilterMode::None;
+    Filter.CanRefine        = false;
     Filter.SearchText.Clear();
 }
 // movement
-int ListViewControlContext::GetVisibleItemsCount()
+int ListViewControlContext::GetVisibleLinesCount()
 {
     int vis = Layout.Height - 3;
     if (Flags && ListViewFlags::HideColumns)
         vis++;
     if (Flags && ListViewFlags::HideBorder)
         vis += 2;
-    int dim = 0, poz = Items.FirstVisibleIndex, nrItems = 0;
-    int sz = (int) Items.Indexes.Len();
-    while ((dim < vis) && (poz < sz))
-    {
-        InternalListViewItem* i = GetFilteredItem(poz);
-        if (i)
-            dim += i->Height;
-        if ((Flags & ListViewFlags::ItemSeparators) != ListViewFlags::None)
-            dim++;
-        nrItems++;
-        poz++;
+    return vis;
+}
+int ListViewControlContext::GetVisibleItemsCount()
+{
+    // the last item that starts on a visible line is counted as well (even if it is partially visible)
+    const int vis   = GetVisibleLinesCount();
+    const int count = (int) Items.Indexes.Len();
+    if ((vis <= 0) || (Items.FirstVisibleIndex >= count))
+        return 0;
+    const auto lastLine = GetItemsLines(Items.FirstVisibleIndex) + (uint32) vis - 1;
+    const auto last     = std::min<>((int) GetItemAtLine(lastLine), count - 1);
+    return last - Items.FirstVisibleIndex + 1;
+}
+void ListViewControlContext::UpdateItemsLines()
+{
+    if (Items.LinesValid)
+        return;
+    const auto count     = Items.Indexes.Len();
+    const auto indexes   = Items.Indexes.GetUInt32Array();
+    const auto separator = (Flags && ListViewFlags::ItemSeparators) ? 1U : 0U;
+    vector<uint32> lines(count);
+    Items.Positions.assign(Items.List.size(), LISTVIEW_INVALID_POSITION);
+    for (uint32 tr = 0; tr < count; tr++)
+    {
+        lines[tr]                    = Items.List[indexes[tr]].Height + separator;
+        Items.Positions[indexes[tr]] = tr;
     }
-    return nrItems;
+    Items.Lines.Build(std::move(lines));
+    Items.LinesValid = true;
+}
+uint32 ListViewControlContext::GetItemsLines(uint32 count)
+{
+    // lines used by the first 'count' items (separators included)
+    const auto lines = (Flags && ListViewFlags::ItemSeparators) ? 2U : 1U;
+    if (Items.TallItems == 0)
+        return count * lines;
+    UpdateItemsLines();
+    return Items.Lines.Sum(count);
+}
+uint32 ListViewControlContext::GetItemAtLine(uint32 line)
+{
+    // position of the item drawn on a line (counted from the first item) - Indexes.Len() if there is no such item
+    const auto lines = (Flags && ListViewFlags::ItemSeparators) ? 2U : 1U;
+    if (Items.TallItems == 0)
+        return std::min<>(line / lines, Items.Indexes.Len());
+    UpdateItemsLines();
+    return Items.Lines.Find(line);
 }
 void ListViewControlContext::UpdateSelectionInfo()
 {
@@ -719,14 +971,19 @@ void ListViewControlContext::MoveTo(int index)
         index = 0;
     if (index == Items.CurentItemIndex)
         return;
-    int vis               = GetVisibleItemsCount();
-    int rel               = index - Items.FirstVisibleIndex;
     int originalPoz       = Items.CurentItemIndex;
     Items.CurentItemIndex = index;
-    if (rel < 0)
+    if (index < Items.FirstVisibleIndex)
         Items.FirstVisibleIndex = index;
-    if (rel >= vis)
-        Items.FirstVisibleIndex = (index - vis) + 1;
+    else
+    {
+        // the separator of the last visible item can be hidden
+        const auto separator = (Flags && ListViewFlags::ItemSeparators) ? 1U : 0U;
+        const auto vis       = (uint32) std::max<>(GetVisibleLinesCount(), 1);
+        const auto end       = GetItemsLines(index + 1) - separator;
+        if (end > GetItemsLines(Items.FirstVisibleIndex) + vis)
+            Items.FirstVisibleIndex = std::min<>((int) GetItemAtLine(end - vis - 1) + 1, index);
+    }
     if (originalPoz != index)
         TriggerListViewItemChangedEvent();
 }
@@ -739,6 +996,7 @@ void ListViewControlContext::CopyToClipboard(bool justCurrentItem)
     ColumnsHeaderView::TableBuilder tb(this->Host, temp);
     if (!tb.Start())
         return;
+    const auto indexes = Items.Indexes.GetUInt32Array();
 
     if (justCurrentItem)
     {
@@ -746,7 +1004,7 @@ void ListViewControlContext::CopyToClipboard(bool justCurrentItem)
             return;
         for (uint32 tr = 0; tr < Header.GetColumnsCount(); tr++)
         {
-            if (!tb.AddString(tr, (CharacterView) (GetFilteredItem(Items.CurentItemIndex)->SubItem[tr])))
+            if (!tb.AddString(tr, (CharacterView) GetCellText(indexes[Items.CurentItemIndex], tr)))
                 return;
         }
     }
@@ -761,7 +1019,7 @@ void ListViewControlContext::CopyToClipboard(bool justCurrentItem)
                 return;
             for (uint32 tr = 0; tr < Header.GetColumnsCount(); tr++)
             {
-                if (!tb.AddString(tr, (CharacterView) (GetFilteredItem(gr)->SubItem[tr])))
+                if (!tb.AddString(tr, (CharacterView) GetCellText(indexes[gr], tr)))
                     return;
             }
         }
@@ -1000,43 +1258,30 @@ void ListViewControlContext::OnMousePressed(int x, int y, Input::MouseButton but
             y -= 2;
     }
 
-    const int itemSeparators = (Flags && ListViewFlags::ItemSeparators) ? 1 : 0;
-    auto cnt                 = GetVisibleItemsCount();
-    auto idx                 = this->Items.FirstVisibleIndex;
-    auto leftPos             = GetLeftPos();
-    int pozY                 = 0;
-    while (cnt > 0)
-    {
-        InternalListViewItem* i = GetFilteredItem(idx);
-        if (i == nullptr)
-            break;
-        int next = pozY + i->Height + itemSeparators;
-        if ((y >= pozY) && (y < next))
+    if (y < 0)
+        return;
+    const int idx = (int) GetItemAtLine(GetItemsLines(this->Items.FirstVisibleIndex) + (uint32) y);
+    if (idx >= this->Items.FirstVisibleIndex + GetVisibleItemsCount())
+        return;
+    // found an item
+    if (idx != this->Items.CurentItemIndex)
+        MoveTo(idx);
+    if (idx == this->Items.CurentItemIndex)
+    {
+        auto i = GetFilteredItem(Items.CurentItemIndex);
+        if (x == (GetLeftPos() + (int) i->XOffset))
         {
-            // found an item
-            if (idx != this->Items.CurentItemIndex)
-                MoveTo(idx);
-            if (idx == this->Items.CurentItemIndex)
-            {
-                auto i = GetFilteredItem(Items.CurentItemIndex);
-                if (x == (leftPos + (int) i->XOffset))
-                {
-                    if ((i->Flags & ITEM_FLAG_CHECKED) != 0)
-                        i->Flags -= ITEM_FLAG_CHECKED;
-                    else
-                        i->Flags |= ITEM_FLAG_CHECKED;
-                    TriggerListViewItemCheckedEvent();
-                }
-                else
-                {
-                    if (((button & Input::MouseButton::DoubleClicked) != Input::MouseButton::None))
-                        TriggerListViewItemPressedEvent();
-                }
-            }
+            if ((i->Flags & ITEM_FLAG_CHECKED) != 0)
+                i->Flags -= ITEM_FLAG_CHECKED;
+            else
+                i->Flags |= ITEM_FLAG_CHECKED;
+            TriggerListViewItemCheckedEvent();
+        }
+        else
+        {
+            if (((button & Input::MouseButton::DoubleClicked) != Input::MouseButton::None))
+                TriggerListViewItemPressedEvent();
         }
-        pozY = next;
-        idx++;
-        cnt--;
     }
 }
 
@@ -1091,11 +1336,7 @@ int SortIndexesCompareFunction(uint32 index_1, uint32 index_2, void* context)
         {
             const auto sortColumnIndex = lvcc->Header.GetSortColumnIndex();
             if (sortColumnIndex.has_value())
-            {
-                const auto sortColIndex = lvcc->Header.GetSortColumnIndex();
-                return lvcc->Items.List[index_1].SubItem[sortColIndex.value()].CompareWith(
-                      lvcc->Items.List[index_2].SubItem[sortColIndex.value()], true);
-            }
+                return lvcc->CompareItems(index_1, index_2, sortColumnIndex.value());
             else
             {
                 if (index_1 < index_2)
@@ -1112,10 +1353,43 @@ int SortIndexesCompareFunction(uint32 index_1, uint32 index_2, void* context)
         return 0; // dont chage the order
     }
 }
+bool ListViewControlContext::SortByValues(uint32 columnIndex)
+{
+    // cells with a value are ordered by their raw keys (no formatting and no text comparison is needed)
+    const auto count = Items.Indexes.Len();
+    auto indexes     = Items.Indexes.GetUInt32Array();
+    vector<std::pair<uint64, uint32>> keys;
+    keys.reserve(count);
+    uint32 textCells = 0;
+    for (uint32 tr = 0; tr < count; tr++)
+    {
+        if (HasItemValue(indexes[tr], columnIndex))
+            keys.emplace_back(GetItemSortKey(indexes[tr], columnIndex), indexes[tr]);
+        else
+            indexes[textCells++] = indexes[tr];
+    }
+    // cells that only have a text are placed first
+    std::sort(
+          indexes,
+          indexes + textCells,
+          [this, columnIndex](uint32 i1, uint32 i2) { return CompareItems(i1, i2, columnIndex) < 0; });
+    std::sort(keys.begin(), keys.end());
+    for (const auto& k : keys)
+        indexes[textCells++] = k.second;
+    if (Header.GetSortDirection() == SortDirection::Descendent)
+        std::reverse(indexes, indexes + count);
+    return true;
+}
 bool ListViewControlContext::Sort()
 {
     // sanity check
     CHECK(Header.GetSortColumnIndex().has_value(), false, "");
+    Items.LinesValid = false;
+    const auto columnIndex   = Header.GetSortColumnIndex().value();
+    const auto hasComparator = (handlers) && (((Handlers::ListView*) (handlers.get()))->ComparereItem.obj);
+    if ((!hasComparator) && (columnIndex < TypedColumns.size()) &&
+        (TypedColumns[columnIndex].Type != ListViewColumnType::Text))
+        return SortByValues(columnIndex);
     Items.Indexes.Sort(SortIndexesCompareFunction, Header.GetSortDirection(), this);
     return true;
 }
@@ -1133,75 +1407,131 @@ int ListViewControlContext::SearchItem(uint32 startPoz)
         return -1;
 
     uint32 originalStartPoz = startPoz;
-    int found               = -1;
     do
     {
-        if (FilterItem(Items.List[startPoz], true))
-        {
-            if (found == -1)
-                found = startPoz;
-        }
+        if (FilterItem(Items.List[startPoz]))
+            return startPoz; // matches are highlighted when the items are painted
         startPoz++;
         if (startPoz >= count)
             startPoz = 0;
 
     } while (startPoz != originalStartPoz);
-    return found;
+    return -1;
 }
-bool ListViewControlContext::FilterItem(InternalListViewItem& lvi, bool clearColorForAll)
+int32 ListViewControlContext::FindSearchText(ItemHandle item, uint32& columnIndex)
 {
-    uint32 columnID         = 0;
-    int index               = -1;
     const auto columnsCount = Header.GetColumnsCount();
-
     for (uint32 gr = 0; gr < columnsCount; gr++)
     {
         if ((Header[gr].flags & InternalColumnFlags::SearcheableValue) == InternalColumnFlags::None)
             continue;
-        index = lvi.SubItem[gr].Find(this->Filter.SearchText.ToStringView(), true);
+        const auto index = GetCellText(item, gr).Find(this->Filter.SearchText.ToStringView(), true);
         if (index >= 0)
         {
-            columnID = gr;
-            break;
-        }
-    }
-    if ((clearColorForAll) || (index >= 0))
-    {
-        // clear all colors
-        for (uint32 gr = 0; gr < columnsCount; gr++)
-        {
-            lvi.SubItem[gr].SetColor(this->Cfg->Text.Inactive);
+            columnIndex = gr;
+            return index;
         }
     }
-    if (index >= 0)
-    {
-        // set color for
-        lvi.SubItem[columnID].SetColor(index, index + this->Filter.SearchText.Len(), this->Cfg->Selection.SearchMarker);
-        return true;
-    }
-
-    return false;
+    return -1;
+}
+bool ListViewControlContext::FilterItem(InternalListViewItem& lvi)
+{
+    uint32 columnIndex;
+    return FindSearchText((ItemHandle) (&lvi - Items.List.data()), columnIndex) >= 0;
+}
+uint64 ListViewControlContext::GetSearchableColumns()
+{
+    const auto columnsCount = std::min<>(Header.GetColumnsCount(), MAX_LISTVIEW_COLUMNS);
+    uint64 mask             = 0;
+    for (uint32 gr = 0; gr < columnsCount; gr++)
+        if ((Header[gr].flags & InternalColumnFlags::SearcheableValue) != InternalColumnFlags::None)
+            mask |= ((uint64) 1) << gr;
+    return mask;
+}
+void ListViewControlContext::AddToSearchIndex(ItemHandle item)
+{
+    if ((Flags & ListViewFlags::SearchIndex) == ListViewFlags::None)
+        return;
+    for (const auto& subItem : Items.List[item].SubItem)
+        SearchIndex.Add(item, subItem);
+}
+void ListViewControlContext::RemoveFromSearchIndex(ItemHandle item)
+{
+    if ((Flags & ListViewFlags::SearchIndex) == ListViewFlags::None)
+        return;
+    for (const auto& subItem : Items.List[item].SubItem)
+        SearchIndex.Remove(item, subItem);
+}
+bool ListViewControlContext::GetSearchCandidates(vector<uint32>& result)
+{
+    if ((Flags & ListViewFlags::SearchIndex) == ListViewFlags::None)
+        return false;
+    // typed cells are searched in their formatted text (that is not indexed)
+    const auto columnsCount = std::min<>(Header.GetColumnsCount(), (uint32) TypedColumns.size());
+    for (uint32 gr = 0; gr < columnsCount; gr++)
+        if ((TypedColumns[gr].Type != ListViewColumnType::Text) &&
+            ((Header[gr].flags & InternalColumnFlags::SearcheableValue) != InternalColumnFlags::None))
+            return false;
+    return SearchIndex.GetCandidates(this->Filter.SearchText.ToStringView(), result);
 }
 void ListViewControlContext::FilterItems()
 {
-    Items.Indexes.Clear();
-    uint32 count = (uint32) Items.List.size();
-    if (this->Filter.SearchText.Len() == 0)
+    const auto searchText = this->Filter.SearchText.ToStringView();
+    const auto columns    = GetSearchableColumns();
+    // items that match a longer text (with the same start) are among the ones that match the previous text
+    const bool refine = (this->Filter.CanRefine) && (this->Filter.FilteredText.Len() > 0) &&
+                        (searchText.size() > this->Filter.FilteredText.Len()) &&
+                        (searchText.starts_with(this->Filter.FilteredText.ToStringView())) &&
+                        (this->Filter.FilteredColumns == columns) &&
+                        (this->Filter.FilteredColumnsCount == Header.GetColumnsCount());
+    vector<uint32> candidates;
+    if (GetSearchCandidates(candidates))
+    {
+        Items.Indexes.Clear();
+        for (const auto tr : candidates)
+        {
+            if (FilterItem(Items.List[tr]))
+                Items.Indexes.Push(tr);
+        }
+    }
+    else if (refine)
     {
-        Items.Indexes.Reserve((uint32) Items.List.size());
+        auto indexes     = Items.Indexes.GetUInt32Array();
+        const auto count = Items.Indexes.Len();
+        uint32 kept      = 0;
         for (uint32 tr = 0; tr < count; tr++)
-            Items.Indexes.Push(tr);
+        {
+            if (FilterItem(Items.List[indexes[tr]]))
+                indexes[kept++] = indexes[tr];
+        }
+        Items.Indexes.Resize(kept);
     }
     else
     {
-        for (uint32 tr = 0; tr < count; tr++)
+        Items.Indexes.Clear();
+        uint32 count = (uint32) Items.List.size();
+        if (searchText.empty())
         {
-            if (FilterItem(Items.List[tr], false))
+            Items.Indexes.Reserve((uint32) Items.List.size());
+            for (uint32 tr = 0; tr < count; tr++)
                 Items.Indexes.Push(tr);
         }
+        else
+        {
+            for (uint32 tr = 0; tr < count; tr++)
+            {
+                if (FilterItem(Items.List[tr]))
+                    Items.Indexes.Push(tr);
+            }
+        }
     }
-    this->Items.FirstVisibleIndex = 0;
-    this->Items.CurentItemIndex   = 0;
+    this->Filter.FilteredText.Set(searchText);
+    this->Filter.FilteredColumns      = columns;
+    this->Filter.FilteredColumnsCount = Header.GetColumnsCount();
+    this->Filter.CanRefine            = true;
+    this->Items.LinesValid            = false;
+    this->Items.FirstVisibleIndex     = 0;
+    this->Items.CurentItemIndex       = 0;
     TriggerListViewItemChangedEvent();
 }
 void ListViewControlContext::UpdateSearch(int startPoz)
@@ -1294,16 +1624,17 @@ uint32 ListViewControlContext::ComputeColumnsPreferedWidth(uint32 columnIndex)
     {
         if (this->Flags && ListViewFlags::CheckBoxes)
             extra += 2;
-        for (auto& itm : this->Items.List)
+        for (uint32 idx = 0; idx < (uint32) this->Items.List.size(); idx++)
         {
-            colSize = std::max<>(colSize, itm.SubItem[columnIndex].Len() + extra + itm.XOffset);
+            const auto& itm = this->Items.List[idx];
+            colSize         = std::max<>(colSize, GetCellText(idx, columnIndex).Len() + extra + itm.XOffset);
         }
     }
     else
     {
-        for (auto& itm : this->Items.List)
+        for (uint32 idx = 0; idx < (uint32) this->Items.List.size(); idx++)
         {
-            colSize = std::max<>(colSize, itm.SubItem[columnIndex].Len());
+            colSize = std::max<>(colSize, GetCellText(idx, columnIndex).Len());
         }
     }
     return colSize;
@@ -1348,8 +1679,11 @@ ListView::ListView(string_view layout, std::initializer_list<ConstString> column
     // initialize
     Members->Items.FirstVisibleIndex   = 0;
     Members->Items.CurentItemIndex     = 0;
+    Members->Items.TallItems           = 0;
+    Members->Items.LinesValid          = false;
     Members->Filter.filterMode         = ListViewFilterMode::None;
     Members->Filter.LastFoundItem      = -1;
+    Members->Filter.CanRefine          = false;
     Members->Host                      = this;
     Members->ScrollBars.OutsideControl = Members->Flags && ListViewFlags::HideBorder;
     Members->Filter.SearchText.Clear();
@@ -1416,6 +1750,10 @@ void ListView::AddItems(std::initializer_list<std::initializer_list<ConstString>
         AddItem(item);
     }
 }
+uint32 ListView::AddItems(uint32 count, const ItemsGenerator& getItem)
+{
+    return WRAPPER->AddItems(count, getItem);
+}
 ListViewItem ListView::GetItem(uint32 index)
 {
     if (this->Context == nullptr)
@@ -1505,6 +1843,10 @@ void ListView::OnFocus()
         WRAPPER->UpdateSelectionInfo();
 }
 
+bool ListView::SetColumnType(uint32 columnIndex, ListViewColumnType type, NumericFormat format)
+{
+    return WRAPPER->SetColumnType(columnIndex, type, format);
+}
 bool ListView::Sort()
 {
     return WRAPPER->Sort();
@@ -1619,6 +1961,34 @@ const Graphics::CharacterBuffer& ListViewItem::GetText(uint32 subItemIndex) cons
     __temp_listviewitem_reference_object__.Destroy();
     return __temp_listviewitem_reference_object__;
 }
+bool ListViewItem::GetFormattedText(uint32 subItemIndex, Graphics::CharacterBuffer& text) const
+{
+    LVICHECK(false);
+    return LVIC->GetItemFormattedText(item, subItemIndex, text);
+}
+bool ListViewItem::SetValue(uint32 subItemIndex, int64 value)
+{
+    LVICHECK(false);
+    return LVIC->SetItemValue(item, subItemIndex, value);
+}
+bool ListViewItem::SetValue(uint32 subItemIndex, uint64 value)
+{
+    LVICHECK(false);
+    return LVIC->SetItemValue(item, subItemIndex, value);
+}
+bool ListViewItem::SetValue(uint32 subItemIndex, double value)
+{
+    LVICHECK(false);
+    return LVIC->SetItemValue(item, subItemIndex, value);
+}
+int32 ListViewItem::CompareWith(const ListViewItem& other, uint32 subItemIndex) const
+{
+    LVICHECK(0);
+    CHECK(other.context == this->context, 0, "Items from different list views can not be compared");
+    CHECK((item < LVIC->Items.List.size()) && (other.item < LVIC->Items.List.size()), 0, "Invalid item");
+    CHECK(subItemIndex < std::min<>(LVIC->Header.GetColumnsCount(), MAX_LISTVIEW_COLUMNS), 0, "Invalid column");
+    return LVIC->CompareItems(item, other.item, subItemIndex);
+}
 bool ListViewItem::SetXOffset(uint32 XOffset)
 {
     LVICHECK(false);
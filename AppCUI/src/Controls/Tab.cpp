@@ -46,6 +46,7 @@ void TabControlContext::UpdateMargins()
         LOG_ERROR("Unknwon TAB display mode: %d", TAB_DISPLAY_MODE(this->Flags));
         break;
     }
+    InvalidateScreenClip();
 }
 int TabControlContext::MousePositionToPanel(int x, int y)
 {
@@ -21,6 +21,13 @@ namespace AppCUI
 using namespace OS;
 constexpr uint32 INVALID_SELECTION  = 0xFFFFFFFFU;
 constexpr uint32 LINE_NUMBERS_WIDTH = 4U;
+// files are indexed in chunks (the first chunk is indexed before the file is displayed)
+constexpr uint64 TEXTAREA_LARGE_FILE_FIRST_CHUNK = 0x100000;
+constexpr uint64 TEXTAREA_LARGE_FILE_CHUNK       = 0x400000;
+// in follow mode the appended bytes are indexed in batches (at most one batch every 50 ms)
+constexpr uint64 TEXTAREA_FOLLOW_BATCH_SIZE     = 0x400000;
+constexpr uint32 TEXTAREA_FOLLOW_BATCH_INTERVAL = 50;
+constexpr uint32 TEXTAREA_FOLLOW_WAIT_TIMEOUT   = 100;
 Internal::TextControlDefaultMenu* textAreaContexMenu = nullptr;
 
 void Controls::UninitTextAreaDefaultMenu()
@@ -379,7 +386,7 @@ void TextAreaControlContext::Paint(Graphics::Renderer& renderer)
     }
     if (Flags & (uint32) TextAreaFlags::ShowLineNumbers)
     {
-        uint32 lnCount = Lines.Len();
+        uint32 lnCount = IsLargeFileMode() ? LargeFile.LinesCount.load() : Lines.Len();
         uint32 tr      = 0;
         uint32 lnIndex = View.TopLine;
         while ((lnIndex < lnCount) && (tr < View.VisibleLinesCount))
@@ -399,6 +406,11 @@ void TextAreaControlContext::Paint(Graphics::Renderer& renderer)
         renderer.DrawVerticalLine(lm - 1, 0, View.VisibleRowsCount, colB);
     }
     renderer.SetClipMargins(lm, tm, rm, bm);
+    if (IsLargeFileMode())
+    {
+        PaintLargeFile(renderer, lm, tm, colTxt);
+        return;
+    }
     for (uint32 tr = 0; tr < View.VisibleLinesCount; tr++)
     {
         DrawLine(renderer, tr + View.TopLine, lm, tr + tm, colTxt);
@@ -780,6 +792,8 @@ void TextAreaControlContext::PasteFromClipboard()
 
 bool TextAreaControlContext::OnKeyEvent(Input::Key KeyCode, char16 UnicodeChar)
 {
+    if (IsLargeFileMode())
+        return OnLargeFileKeyEvent(KeyCode);
     switch (KeyCode)
     {
     case Key::Left:
@@ -941,6 +955,14 @@ void TextAreaControlContext::OnMouseReleased(int /*x*/, int /*y*/, Input::MouseB
 void TextAreaControlContext::OnMousePressed(int x, int y, Input::MouseButton button)
 {
     uint32 lineIndex, ofs;
+    if (IsLargeFileMode())
+    {
+        if (Flags & (uint32) TextAreaFlags::Border)
+            y--;
+        if ((button == MouseButton::Left) && (y >= 0))
+            LargeFileMoveTo(View.TopLine + (uint32) y);
+        return;
+    }
     if (button == MouseButton::Left)
     {
         MousePosToFilePos(x, y, lineIndex, ofs);
@@ -974,6 +996,8 @@ void TextAreaControlContext::OnMousePressed(int x, int y, Input::MouseButton but
 bool TextAreaControlContext::OnMouseDrag(int x, int y, Input::MouseButton button)
 {
     uint32 lineIndex, ofs;
+    if (IsLargeFileMode())
+        return false;
     if (button == MouseButton::Left)
     {
         MousePosToFilePos(x, y, lineIndex, ofs);
@@ -986,9 +1010,13 @@ bool TextAreaControlContext::OnMouseWheel(int /*x*/, int /*y*/, Input::MouseWhee
     switch (direction)
     {
     case MouseWheel::Up:
+        if (IsLargeFileMode())
+            return OnLargeFileKeyEvent(Key::Up);
         MoveUpDown(1, true, false);
         return true;
     case MouseWheel::Down:
+        if (IsLargeFileMode())
+            return OnLargeFileKeyEvent(Key::Down);
         MoveUpDown(1, false, false);
         return true;
     }
@@ -1010,7 +1038,10 @@ bool TextAreaControlContext::OnMouseEnter()
 void TextAreaControlContext::OnAfterResize()
 {
     ComputeVisibleLinesAndRows();
-    UpdateLines();
+    if (IsLargeFileMode())
+        LargeFileMoveTo(View.CurrentLine);
+    else
+        UpdateLines();
 }
 void TextAreaControlContext::SetToolTip(char*)
 {
@@ -1019,7 +1050,7 @@ void TextAreaControlContext::SetToolTip(char*)
 }
 bool TextAreaControlContext::IsReadOnly()
 {
-    return ((Flags & (uint32) TextAreaFlags::Readonly) != 0);
+    return ((Flags & (uint32) TextAreaFlags::Readonly) != 0) || (IsLargeFileMode());
 }
 void TextAreaControlContext::SetReadOnly(bool value)
 {
@@ -1067,9 +1098,325 @@ bool TextAreaControlContext::OnEvent(Event eventType, int ID)
     }
     return false;
 }
+bool TextAreaControlContext::OpenLargeFile(const std::filesystem::path& filePath)
+{
+    CloseLargeFile();
+    uint64 fileSize;
+    CHECK(Internal::GetFileIdentity(filePath, LargeFile.FileID, fileSize),
+          false,
+          "Fail to read the attributes of: %s",
+          filePath.string().c_str());
+    CHECK(LargeFile.File.OpenRead(filePath), false, "Fail to open: %s", filePath.string().c_str());
+    LargeFile.Path              = filePath;
+    LargeFile.Stop              = false;
+    LargeFile.IndexedBytes      = 0;
+    LargeFile.LinesCount        = 0;
+    LargeFile.PaintedLinesCount = 0;
+    LargeFile.LineStarts.clear();
+    LargeFile.LineStarts.push_back(0);
+    View.CurrentLine      = 0;
+    View.CurrentPosition  = 0;
+    View.HorizontalOffset = 0;
+    View.TopLine          = 0;
+    ClearSel();
+
+    // the first lines are indexed right away (so that the first screen can be painted), the rest in background
+    std::vector<uint64> lines;
+    const auto size     = LargeFile.File.GetSize();
+    const auto firstEnd = std::min<uint64>(size, TEXTAREA_LARGE_FILE_FIRST_CHUNK);
+    IndexLargeFileLines(0, firstEnd, lines);
+    PublishLargeFileLines(lines, firstEnd == size);
+    LargeFile.IndexedBytes = firstEnd;
+    RestartLargeFileIndexer();
+    return true;
+}
+void TextAreaControlContext::CloseLargeFile()
+{
+    LargeFile.Stop = true;
+    if (LargeFile.Indexer.valid())
+    {
+        LargeFile.Indexer.wait();
+        LargeFile.Indexer = std::future<void>();
+    }
+    LargeFile.Running  = false;
+    LargeFile.Indexing = false;
+    LargeFile.Follow   = false;
+    Host->DisableFrameUpdates();
+    LargeFile.File.Close();
+    LargeFile.Path.clear();
+    LargeFile.LineStarts.clear();
+    LargeFile.LineStarts.shrink_to_fit();
+    LargeFile.LinesCount        = 0;
+    LargeFile.PaintedLinesCount = 0;
+    LargeFile.IndexedBytes      = 0;
+}
+void TextAreaControlContext::RestartLargeFileIndexer()
+{
+    // the indexer continues from the last published chunk
+    LargeFile.Stop = true;
+    if (LargeFile.Indexer.valid())
+    {
+        LargeFile.Indexer.wait();
+        LargeFile.Indexer = std::future<void>();
+    }
+    LargeFile.Stop     = false;
+    LargeFile.Indexing = LargeFile.IndexedBytes < LargeFile.File.GetSize();
+    LargeFile.Running  = LargeFile.Indexing || LargeFile.Follow;
+    if (LargeFile.Running)
+    {
+        // in follow mode the indexer waits for file changes --> it does not use one of the shared worker threads
+        const auto start  = LargeFile.IndexedBytes.load();
+        LargeFile.Indexer = Internal::RunLongTask([this, start]() { LargeFileIndexer(start); });
+        if (LargeFile.Indexer.valid())
+        {
+            Host->EnableFrameUpdates(); // indexed lines are shown as they become available
+        }
+        else
+        {
+            LargeFile.Indexing = false;
+            LargeFile.Running  = false;
+        }
+    }
+}
+void TextAreaControlContext::IndexLargeFileLines(uint64 start, uint64 end, std::vector<uint64>& lines)
+{
+    const auto* data = LargeFile.File.GetData();
+    const auto* p    = data + start;
+    const auto* e    = data + end;
+    while (p < e)
+    {
+        p = reinterpret_cast<const uint8*>(memchr(p, NEW_LINE_CODE, (size_t) (e - p)));
+        if (!p)
+            break;
+        p++;
+        lines.push_back((uint64) (p - data));
+    }
+}
+bool TextAreaControlContext::PublishLargeFileLines(std::vector<uint64>& lines, bool finished)
+{
+    std::lock_guard<std::mutex> lock(LargeFile.Lock);
+    CHECK(LargeFile.LineStarts.size() + lines.size() < 0xFFFFFFFFULL,
+          false,
+          "Too many lines - only the first part of the file will be displayed");
+    LargeFile.LineStarts.insert(LargeFile.LineStarts.end(), lines.begin(), lines.end());
+    // the end of the last line is known only after the entire file was indexed
+    LargeFile.LinesCount = (uint32) (finished ? LargeFile.LineStarts.size() : LargeFile.LineStarts.size() - 1);
+    lines.clear();
+    return true;
+}
+void TextAreaControlContext::LargeFileIndexer(uint64 start)
+{
+    const auto size = LargeFile.File.GetSize();
+    std::vector<uint64> lines;
+    bool linesLimitReached = false;
+    while ((start < size) && (!LargeFile.Stop))
+    {
+        const auto end = std::min<uint64>(size, start + TEXTAREA_LARGE_FILE_CHUNK);
+        IndexLargeFileLines(start, end, lines);
+        if (!PublishLargeFileLines(lines, end == size))
+        {
+            linesLimitReached = true;
+            break;
+        }
+        LargeFile.IndexedBytes = end;
+        start                  = end;
+    }
+    LargeFile.Indexing = false;
+    if (!linesLimitReached)
+        FollowLargeFile();
+    LargeFile.Running = false;
+}
+bool TextAreaControlContext::RemapLargeFile(uint64& indexedBytes)
+{
+    uint64 id, size;
+    if (!Internal::GetFileIdentity(LargeFile.Path, id, size))
+        return false;
+    // a file that was replaced (log rotation) can have any size --> its identity is checked as well
+    const auto replaced = id != LargeFile.FileID;
+    // only this thread changes the mapping --> it can be checked without a lock
+    if ((LargeFile.File.GetData()) && (size == LargeFile.File.GetSize()) && (!replaced))
+        return indexedBytes < size;
+
+    std::lock_guard<std::mutex> lock(LargeFile.Lock);
+    auto resetIndex = [this, &indexedBytes]()
+    {
+        LargeFile.LineStarts.clear();
+        LargeFile.LineStarts.push_back(0);
+        LargeFile.LinesCount   = 0;
+        LargeFile.IndexedBytes = 0;
+        indexedBytes           = 0;
+    };
+    // the file was truncated or replaced --> it is indexed again
+    if ((replaced) || (size < indexedBytes))
+        resetIndex();
+    LargeFile.FileID = id;
+    if (size == 0)
+    {
+        LargeFile.File.Close();
+        return false;
+    }
+    if (!LargeFile.File.OpenRead(LargeFile.Path))
+        return false;
+    // a file that was truncated and re-written in place (copy-truncate rotation) keeps its identity --> the last
+    // indexed line must still start after a new line
+    const auto lastLine = LargeFile.LineStarts.back();
+    if ((lastLine > LargeFile.File.GetSize()) ||
+        ((lastLine > 0) && (LargeFile.File.GetData()[lastLine - 1] != NEW_LINE_CODE)))
+        resetIndex();
+    return indexedBytes < LargeFile.File.GetSize();
+}
+void TextAreaControlContext::FollowLargeFile()
+{
+    Internal::FileChangesWatcher watcher(LargeFile.Path);
+    std::vector<uint64> lines;
+    uint64 indexed = LargeFile.IndexedBytes;
+    while ((LargeFile.Follow) && (!LargeFile.Stop))
+    {
+        if (!RemapLargeFile(indexed))
+        {
+            watcher.Wait(TEXTAREA_FOLLOW_WAIT_TIMEOUT);
+            continue;
+        }
+        // the new bytes are published in batches with a pause between them, so that a burst of appended lines
+        // does not keep the UI thread busy
+        const auto end = std::min<uint64>(LargeFile.File.GetSize(), indexed + TEXTAREA_FOLLOW_BATCH_SIZE);
+        IndexLargeFileLines(indexed, end, lines);
+        if (!PublishLargeFileLines(lines, true))
+            break;
+        LargeFile.IndexedBytes = end;
+        indexed                = end;
+        if (indexed < LargeFile.File.GetSize())
+            std::this_thread::sleep_for(std::chrono::milliseconds(TEXTAREA_FOLLOW_BATCH_INTERVAL));
+    }
+}
+bool TextAreaControlContext::SetLargeFileFollowMode(bool enabled)
+{
+    CHECK(IsLargeFileMode(), false, "Follow mode can only be used for files opened with OpenFile !");
+    if (LargeFile.Follow == enabled)
+        return true;
+    LargeFile.Follow = enabled;
+    RestartLargeFileIndexer();
+    return true;
+}
+bool TextAreaControlContext::DecodeLargeFileLine(uint64 start, uint64 end, uint32 skipCharacters, uint32 maxCharacters)
+{
+    const auto* p = reinterpret_cast<const char8*>(LargeFile.File.GetData() + start);
+    const auto* e = reinterpret_cast<const char8*>(LargeFile.File.GetData() + end);
+    Utils::UnicodeChar uc;
+    Character ch;
+    uint32 column = 0;
+    bool isTab;
+
+    ch.Color = NoColorPair;
+    LargeFile.Line.clear();
+    while ((p < e) && (LargeFile.Line.size() < maxCharacters))
+    {
+        isTab = (*p) == '\t';
+        if ((*p) < 0x80)
+        {
+            ch.Code = isTab ? this->tabChar : (char16) (*p);
+            p++;
+        }
+        else if (Utils::ConvertUTF8CharToUnicodeChar(p, e, uc))
+        {
+            ch.Code = uc.Value;
+            p += uc.Length;
+        }
+        else
+        {
+            ch.Code = '?';
+            p++;
+        }
+        // same tab alignament as the one used for the text (4 characters)
+        auto width = isTab ? 4 - (column & 3) : 1;
+        for (; width > 0; width--, column++)
+        {
+            if ((column >= skipCharacters) && (LargeFile.Line.size() < maxCharacters))
+                LargeFile.Line.push_back(ch);
+            ch.Code = ' ';
+        }
+    }
+    return !LargeFile.Line.empty();
+}
+void TextAreaControlContext::LargeFileMoveTo(uint32 lineIndex)
+{
+    const auto count = LargeFile.LinesCount.load();
+    View.CurrentLine = count > 0 ? std::min<>(lineIndex, count - 1) : 0;
+    if (View.CurrentLine < View.TopLine)
+        View.TopLine = View.CurrentLine;
+    else if ((View.VisibleLinesCount > 0) && (View.CurrentLine >= View.TopLine + View.VisibleLinesCount))
+        View.TopLine = View.CurrentLine - (View.VisibleLinesCount - 1);
+}
+void TextAreaControlContext::PaintLargeFile(Graphics::Renderer& renderer, int x, int y, const ColorPair textColor)
+{
+    // the indexer can add new lines (or re-map the file in follow mode) in the meantime
+    std::lock_guard<std::mutex> lock(LargeFile.Lock);
+    const auto* data       = LargeFile.File.GetData();
+    const auto fileSize    = LargeFile.File.GetSize();
+    const auto linesCount  = (size_t) LargeFile.LinesCount.load();
+    const auto& lineStarts = LargeFile.LineStarts;
+    if (data == nullptr)
+        return;
+    for (uint32 tr = 0; (tr < View.VisibleLinesCount) && ((size_t) View.TopLine + tr < linesCount); tr++)
+    {
+        const auto index = (size_t) View.TopLine + tr;
+        const auto start = lineStarts[index];
+        auto end         = index + 1 < lineStarts.size() ? lineStarts[index + 1] : fileSize;
+        // skip the new line (LF or CR-LF)
+        if ((end > start) && (data[end - 1] == NEW_LINE_CODE))
+            end--;
+        if ((end > start) && (data[end - 1] == '\r'))
+            end--;
+        if ((end > fileSize) || (!DecodeLargeFileLine(start, end, View.HorizontalOffset, View.VisibleRowsCount + 1)))
+            continue;
+        for (auto& ch : LargeFile.Line)
+            ch.Color = textColor;
+        renderer.WriteSingleLineCharacterBuffer(
+              x, y + (int) tr, CharacterView(LargeFile.Line.data(), LargeFile.Line.size()), false);
+    }
+    if ((Focused) && (View.CurrentLine >= View.TopLine))
+        renderer.SetCursor(x, y + (int) (View.CurrentLine - View.TopLine));
+}
+bool TextAreaControlContext::OnLargeFileKeyEvent(Input::Key keyCode)
+{
+    switch (keyCode)
+    {
+    case Key::Up:
+        LargeFileMoveTo(View.CurrentLine > 0 ? View.CurrentLine - 1 : 0);
+        return true;
+    case Key::Down:
+        LargeFileMoveTo(View.CurrentLine + 1);
+        return true;
+    case Key::PageUp:
+        LargeFileMoveTo(View.CurrentLine > View.VisibleLinesCount ? View.CurrentLine - View.VisibleLinesCount : 0);
+        return true;
+    case Key::PageDown:
+        LargeFileMoveTo((uint32) std::min<uint64>((uint64) View.CurrentLine + View.VisibleLinesCount, 0xFFFFFFFFULL));
+        return true;
+    case Key::Left:
+        if (View.HorizontalOffset > 0)
+            View.HorizontalOffset--;
+        return true;
+    case Key::Right:
+        View.HorizontalOffset++;
+        return true;
+    case Key::Home:
+        View.HorizontalOffset = 0;
+        return true;
+    case Key::Ctrl | Key::Home:
+        View.HorizontalOffset = 0;
+        LargeFileMoveTo(0);
+        return true;
+    case Key::Ctrl | Key::End:
+        LargeFileMoveTo(0xFFFFFFFF);
+        return true;
+    }
+    return false;
+}
 //======================================================================================================================================================================
 TextArea::~TextArea()
 {
+    WRAPPER->CloseLargeFile();
     DELETE_CONTROL_CONTEXT(TextAreaControlContext);
 }
 TextArea::TextArea(const ConstString& caption, string_view layout, TextAreaFlags flags)
@@ -1089,10 +1436,17 @@ TextArea::TextArea(const ConstString& caption, string_view layout, TextAreaFlags
         Members->Flags |= GATTR_VSCROLL;
         Members->ScrollBars.OutsideControl = (((uint32) flags & (uint32) TextAreaFlags::Border) == 0);
     }
-    Members->tabChar              = ' ';
-    Members->View.CurrentPosition = 0;
-    Members->View.TopLine         = 0;
-    Members->Host                 = this;
+    Members->tabChar                     = ' ';
+    Members->LargeFile.Stop              = false;
+    Members->LargeFile.Running           = false;
+    Members->LargeFile.Indexing          = false;
+    Members->LargeFile.Follow            = false;
+    Members->LargeFile.IndexedBytes      = 0;
+    Members->LargeFile.LinesCount        = 0;
+    Members->LargeFile.PaintedLinesCount = 0;
+    Members->View.CurrentPosition        = 0;
+    Members->View.TopLine                = 0;
+    Members->Host                        = this;
     Members->ComputeVisibleLinesAndRows();
     Members->ClearSel();
     Members->AnalyzeCurrentText();
@@ -1143,6 +1497,12 @@ void TextArea::OnAfterResize(int, int)
 void TextArea::OnUpdateScrollBars()
 {
     CREATE_TYPECONTROL_CONTEXT(TextAreaControlContext, Members, );
+    if (Members->IsLargeFileMode())
+    {
+        const auto count = Members->LargeFile.LinesCount.load();
+        UpdateVScrollBar(Members->View.CurrentLine, count > 0 ? count - 1 : 0);
+        return;
+    }
     UpdateVScrollBar(Members->View.CurrentLine, Members->Lines.Len() - 1);
 }
 void TextArea::OnFocus()
@@ -1155,6 +1515,7 @@ void TextArea::OnFocus()
 void TextArea::OnAfterSetText()
 {
     CREATE_TYPECONTROL_CONTEXT(TextAreaControlContext, Members, );
+    Members->CloseLargeFile();
     Members->AnalyzeCurrentText();
 }
 void TextArea::SetReadOnly(bool value)
@@ -1181,6 +1542,62 @@ bool TextArea::GetSelection(uint32& start, uint32& size) const
     size  = WRAPPER->Selection.End - WRAPPER->Selection.Start;
     return true;
 }
+bool TextArea::OpenFile(const std::filesystem::path& filePath)
+{
+    CREATE_TYPECONTROL_CONTEXT(TextAreaControlContext, Members, false);
+    // the text (if any) is not needed anymore
+    Members->Text.Clear();
+    Members->AnalyzeCurrentText();
+    return Members->OpenLargeFile(filePath);
+}
+void TextArea::CloseFile()
+{
+    WRAPPER->CloseLargeFile();
+}
+bool TextArea::IsIndexingFile() const
+{
+    return WRAPPER->LargeFile.Indexing;
+}
+uint32 TextArea::GetIndexingProgress() const
+{
+    if (!WRAPPER->LargeFile.Indexing)
+        return 100;
+    // the indexer re-maps the file (in follow mode) under this lock
+    std::lock_guard<std::mutex> lock(WRAPPER->LargeFile.Lock);
+    const auto size = WRAPPER->LargeFile.File.GetSize();
+    return size > 0 ? (uint32) ((WRAPPER->LargeFile.IndexedBytes.load() * 100) / size) : 100;
+}
+bool TextArea::SetFollowMode(bool enabled)
+{
+    CREATE_TYPECONTROL_CONTEXT(TextAreaControlContext, Members, false);
+    return Members->SetLargeFileFollowMode(enabled);
+}
+bool TextArea::OnFrameUpdate()
+{
+    // the lines that are indexed in background become visible (and the scroll bar is updated)
+    CREATE_TYPECONTROL_CONTEXT(TextAreaControlContext, Members, false);
+    const auto count    = Members->LargeFile.LinesCount.load();
+    const auto painted  = Members->LargeFile.PaintedLinesCount;
+    const auto finished = (!Members->LargeFile.Running) && (Members->LargeFile.Indexer.valid());
+    if ((count == painted) && (!finished))
+        return false;
+    Members->LargeFile.PaintedLinesCount = count;
+    if (finished)
+    {
+        Members->LargeFile.Indexer.wait();
+        Members->LargeFile.Indexer = std::future<void>();
+        DisableFrameUpdates();
+    }
+    // the file was truncated (and indexed again) --> the view starts from the first line
+    if (count < painted)
+        Members->View.TopLine = 0;
+    // in follow mode the view scrolls only if the last line was the current one
+    if ((Members->LargeFile.Follow) && (count != painted) && (Members->View.CurrentLine + 1 >= painted))
+        Members->LargeFileMoveTo(count - 1);
+    else
+        Members->LargeFileMoveTo(Members->View.CurrentLine);
+    return true;
+}
 
 Handlers::TextControl* TextArea::Handlers()
 {
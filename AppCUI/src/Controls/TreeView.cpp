@@ -1,5 +1,6 @@
 #include "ControlContext.hpp"
 
+#include <chrono>
 #include <queue>
 
 namespace AppCUI::Controls
@@ -9,6 +10,8 @@ constexpr auto TreeScrollbarLeftOffset = 25U;
 constexpr auto ItemSymbolOffset        = 2U;
 constexpr auto BorderOffset            = 1U;
 constexpr auto InvalidIndex            = 0xFFFFFFFFU;
+constexpr auto ChildrenLoaderBatch     = 1024U;
+constexpr auto ChildrenLoaderInterval  = std::chrono::milliseconds(30); // a slow loader still shows its children
 
 const static Utils::UnicodeStringBuilder cb{};
 
@@ -72,8 +75,12 @@ TreeView::TreeView(string_view layout, std::initializer_list<ConstString> column
     }
 
     cc->AdjustItemsBoundsOnResize();
+}
 
-    cc->SetColorForItems(cc->Cfg->Text.Normal);
+TreeView::~TreeView()
+{
+    reinterpret_cast<TreeControlContext*>(Context)->StopAllChildrenLoads();
+    DELETE_CONTROL_CONTEXT(TreeControlContext);
 }
 
 void TreeView::Paint(Graphics::Renderer& renderer)
@@ -310,7 +317,6 @@ bool TreeView::OnKeyEvent(Input::Key keyCode, char16 character)
             if (cc->filter.searchText.Len() > 0)
             {
                 cc->filter.searchText.Clear();
-                cc->SetColorForItems(cc->Cfg->Text.Normal);
                 return true;
             }
         }
@@ -319,7 +325,6 @@ bool TreeView::OnKeyEvent(Input::Key keyCode, char16 character)
             if (cc->filter.searchText.Len() > 0)
             {
                 cc->filter.searchText.Clear();
-                cc->SetColorForItems(cc->Cfg->Text.Normal);
                 cc->ProcessItemsToBeDrawn(InvalidItemHandle);
                 return true;
             }
@@ -443,7 +448,6 @@ bool TreeView::OnKeyEvent(Input::Key keyCode, char16 character)
         if (character > 0)
         {
             cc->filter.searchText.AddChar(character);
-            cc->SetColorForItems(cc->Cfg->Text.Normal);
             if (cc->SearchItems() == false)
             {
                 cc->filter.searchText.Truncate(cc->filter.searchText.Len() - 1);
@@ -454,7 +458,6 @@ bool TreeView::OnKeyEvent(Input::Key keyCode, char16 character)
                 else
                 {
                     cc->notProcessed = true;
-                    cc->SetColorForItems(cc->Cfg->Text.Normal);
                 }
             }
             return true;
@@ -649,6 +652,12 @@ void TreeView::OnAfterResize(int newWidth, int newHeight)
     ColumnsHeaderView::OnAfterResize(newWidth, newHeight);
 }
 
+bool TreeView::OnFrameUpdate()
+{
+    CHECK(Context != nullptr, false, "");
+    return reinterpret_cast<TreeControlContext*>(Context)->ProcessLoadedChildren();
+}
+
 void TreeView::OnColumnClicked(uint32 /*columnIndex*/)
 {
     this->Sort();
@@ -768,6 +777,7 @@ TreeViewItem TreeViewItem::GetChild(uint32 index)
 bool TreeViewItem::DeleteChildren()
 {
     CREATE_TREE_VIEW_ITEM_CONTEXT(false);
+    cc->StopChildrenLoad(cc->items.at(handle));
 
     const auto noChildren = GetChildrenCount();
     for (auto i = 0U; i < noChildren; i++)
@@ -790,7 +800,10 @@ bool TreeViewItem::Toggle(bool recursiveCall)
     CREATE_TREE_VIEW_ITEM_CONTEXT(false);
     CHECK(IsExpandable(), true, "");
 
-    if (cc->treeFlags && TreeViewFlags::DynamicallyPopulateNodeChildren)
+    // folding an item whose children are still being loaded cancels the load (the children received so far are
+    // dropped and the load starts again when the item is unfolded)
+    auto& item = cc->items.at(handle);
+    if ((cc->StopChildrenLoad(item)) || (cc->treeFlags && TreeViewFlags::DynamicallyPopulateNodeChildren))
     {
         CHECK(DeleteChildren(), false, "");
     }
@@ -799,6 +812,10 @@ bool TreeViewItem::Toggle(bool recursiveCall)
 
     if (!IsFolded())
     {
+        if ((item.childrenLoader) && (item.children.empty()))
+        {
+            CHECK(cc->StartChildrenLoad(handle), false, "");
+        }
         if (cc->treeFlags && TreeViewFlags::DynamicallyPopulateNodeChildren)
         {
             return cc->TriggerOnItemToggled(*this, recursiveCall);
@@ -906,16 +923,48 @@ bool TreeViewItem::SetPriority(uint32 priority) const
     return true;
 }
 
+bool TreeViewItem::SetChildrenLoader(TreeViewChildrenLoader loader)
+{
+    CREATE_TREE_VIEW_ITEM_CONTEXT(false);
+    CHECK(DeleteChildren(), false, "");
+
+    auto& item          = cc->items.at(handle);
+    item.childrenLoader = std::move(loader);
+    item.isExpandable   = item.childrenLoader != nullptr;
+    if ((item.childrenLoader) && (item.expanded))
+    {
+        CHECK(cc->StartChildrenLoad(handle), false, "");
+    }
+    cc->notProcessed = true;
+    return true;
+}
+
+bool TreeViewItem::IsLoadingChildren() const
+{
+    CREATE_TREE_VIEW_ITEM_CONTEXT(false);
+    return cc->items.at(handle).childrenLoad != nullptr;
+}
+
 TreeViewItem TreeViewItem::AddChild(ConstString name, bool isExpandable)
 {
     CREATE_TREE_VIEW_ITEM_CONTEXT(TreeViewItem());
     return { obj, cc->AddItem(handle, { name }, isExpandable) };
 }
 
+uint32 TreeViewItem::AddChildren(uint32 count, const ItemsGenerator& getItem)
+{
+    CREATE_TREE_VIEW_ITEM_CONTEXT(0);
+    return cc->AddItems(handle, count, getItem);
+}
+
 bool TreeViewItem::SetText(ConstString name)
 {
     CREATE_TREE_VIEW_ITEM_CONTEXT(false)
-    return cc->items.at(handle).values.at(0).Set(name);
+    auto& item = cc->items.at(handle);
+    cc->RemoveFromSearchIndex(item);
+    const auto result = item.values.at(0).Set(name);
+    cc->AddToSearchIndex(item);
+    return result;
 }
 
 const CharacterBuffer& TreeViewItem::GetText() const
@@ -935,8 +984,10 @@ bool TreeViewItem::SetValues(const std::initializer_list<ConstString> values)
 {
     CREATE_TREE_VIEW_ITEM_CONTEXT(false);
 
-    auto& vals = cc->items.at(handle).values;
-    auto it    = vals.begin();
+    auto& item = cc->items.at(handle);
+    auto& vals = item.values;
+    cc->RemoveFromSearchIndex(item);
+    auto it = vals.begin();
     std::advance(it, 1); // past name
 
     bool end = (it == vals.end());
@@ -955,6 +1006,7 @@ bool TreeViewItem::SetValues(const std::initializer_list<ConstString> values)
             end = (it == vals.end());
         }
     }
+    cc->AddToSearchIndex(item);
 
     return true;
 }
@@ -970,7 +1022,10 @@ bool TreeViewItem::SetText(uint32 subItemIndex, const ConstString& text)
         item.values.resize(subItemIndex + 1ULL);
     }
 
-    return item.values.at(subItemIndex).Set(text);
+    cc->RemoveFromSearchIndex(item);
+    const auto result = item.values.at(subItemIndex).Set(text);
+    cc->AddToSearchIndex(item);
+    return result;
 }
 
 const Graphics::CharacterBuffer& TreeViewItem::GetText(uint32 subItemIndex) const
@@ -1030,7 +1085,9 @@ bool TreeView::ClearItems()
     CHECK(Context != nullptr, false, "");
     const auto cc = reinterpret_cast<TreeControlContext*>(Context);
 
+    cc->StopAllChildrenLoads();
     cc->items.clear();
+    cc->searchIndex.Clear();
 
     cc->nextItemHandle = 1ULL;
 
@@ -1081,6 +1138,14 @@ TreeViewItem TreeView::AddItem(ConstString name, bool isExpandable)
     return { this->Context, cc->AddItem(InvalidItemHandle, { name }, isExpandable) };
 }
 
+uint32 TreeView::AddItems(uint32 count, const ItemsGenerator& getItem)
+{
+    auto cc = reinterpret_cast<TreeControlContext*>(this->Context);
+    CHECK(cc != nullptr, 0, "");
+
+    return cc->AddItems(InvalidItemHandle, count, getItem);
+}
+
 bool TreeView::Sort()
 {
     CHECK(Context != nullptr, false, "");
@@ -1440,35 +1505,21 @@ bool TreeControlContext::AdjustItemsBoundsOnResize()
     return true;
 }
 
-bool TreeControlContext::SetColorForItems(const ColorPair& color)
-{
-    for (auto& item : items)
-    {
-        for (auto& value : item.second.values)
-        {
-            value.SetColor(color);
-        }
-    }
-
-    return true;
-}
-
 bool TreeControlContext::SearchItems()
 {
     bool found = false;
 
     MarkAllItemsAsNotFound();
-    SetColorForItems(Cfg->Text.Normal);
     ItemComparator ic(host);
 
     std::set<ItemHandle> toBeExpanded;
     if (filter.searchText.Len() > 0)
     {
-        for (auto& item : items)
+        auto checkItem = [&](std::pair<const ItemHandle, TreeItem>& item)
         {
             for (auto& value : item.second.values)
             {
-                if (const auto index = value.Find(filter.searchText.ToStringView(), true); index >= 0)
+                if (value.Find(filter.searchText.ToStringView(), true) >= 0)
                 {
                     item.second.markedAsFound = true;
                     if (filter.mode == TreeControlContext::FilterMode::Filter)
@@ -1497,7 +1548,6 @@ bool TreeControlContext::SearchItems()
                     }
 
                     found = true;
-                    value.SetColor(index, index + filter.searchText.Len(), Cfg->Selection.SearchMarker);
 
                     ItemHandle ancestorHandle = item.second.parent;
                     do
@@ -1519,6 +1569,21 @@ bool TreeControlContext::SearchItems()
                     } while (ancestorHandle != InvalidItemHandle);
                 }
             }
+        };
+
+        // with an index only the items that contain all the trigrams of the text are checked
+        vector<uint32> candidates;
+        if (((treeFlags & TreeViewFlags::SearchIndex) != TreeViewFlags::None) &&
+            (searchIndex.GetCandidates(filter.searchText.ToStringView(), candidates)))
+        {
+            for (const auto handle : candidates)
+                if (const auto it = items.find(handle); it != items.end())
+                    checkItem(*it);
+        }
+        else
+        {
+            for (auto& item : items)
+                checkItem(item);
         }
     }
 
@@ -1644,7 +1709,8 @@ bool TreeControlContext::PaintItems(Graphics::Renderer& renderer)
                 }
                 else if (item.markedAsFound)
                 {
-                    // nothing - color already set
+                    // the matches are highlighted when painted (only visible items are changed)
+                    wtp.Color = Cfg->Text.Normal;
                 }
                 else
                 {
@@ -1682,14 +1748,23 @@ bool TreeControlContext::PaintItems(Graphics::Renderer& renderer)
                     }
                 }
 
-                if (item.markedAsFound == false)
-                {
-                    item.values[j].SetColor(wtp.Color);
-                }
-
                 if (wtp.X < static_cast<int>(col.x + col.width))
                 {
-                    renderer.WriteText(item.values[j], wtp);
+                    // the item keeps its colors --> the match is colored in a copy of the value
+                    const auto index =
+                          item.markedAsFound ? item.values[j].Find(filter.searchText.ToStringView(), true) : -1;
+                    if (index >= 0)
+                    {
+                        searchCell.Set(item.values[j]);
+                        searchCell.SetColor(wtp.Color);
+                        searchCell.SetColor(index, index + filter.searchText.Len(), Cfg->Selection.SearchMarker);
+                        renderer.WriteText(searchCell, wtp);
+                    }
+                    else
+                    {
+                        wtp.Flags |= WriteTextFlags::OverwriteColors;
+                        renderer.WriteText(item.values[j], wtp);
+                    }
                 }
             }
 
@@ -1925,15 +2000,17 @@ bool TreeControlContext::RemoveItem(const ItemHandle handle)
         ItemHandle current = ancestorRelated.front();
         ancestorRelated.pop();
 
-        if (const auto it = items.find(handle); it != items.end())
+        if (const auto it = items.find(current); it != items.end())
         {
-            for (const auto& handle : items.at(current).children)
+            for (const auto& handle : it->second.children)
             {
                 ancestorRelated.push(handle);
             }
+            StopChildrenLoad(it->second);
+            RemoveFromSearchIndex(it->second);
             items.erase(it);
 
-            if (const auto rootIt = std::find(roots.begin(), roots.end(), handle); rootIt != roots.end())
+            if (const auto rootIt = std::find(roots.begin(), roots.end(), current); rootIt != roots.end())
             {
                 roots.erase(rootIt);
             }
@@ -1945,6 +2022,184 @@ bool TreeControlContext::RemoveItem(const ItemHandle handle)
     return true;
 }
 
+void TreeControlContext::AddToSearchIndex(const TreeItem& item)
+{
+    if ((treeFlags & TreeViewFlags::SearchIndex) == TreeViewFlags::None)
+        return;
+    for (const auto& value : item.values)
+        searchIndex.Add(item.handle, value);
+}
+
+void TreeControlContext::RemoveFromSearchIndex(const TreeItem& item)
+{
+    if ((treeFlags & TreeViewFlags::SearchIndex) == TreeViewFlags::None)
+        return;
+    for (const auto& value : item.values)
+        searchIndex.Remove(item.handle, value);
+}
+
+// runs on a worker thread --> the children are sent to the UI thread in batches
+class TreeChildrenSender : public TreeViewChildrenReceiver
+{
+    std::shared_ptr<TreeChildrenLoad> load;
+    vector<TreeChildrenLoad::Child> batch;
+    std::chrono::steady_clock::time_point lastSent;
+
+  public:
+    TreeChildrenSender(std::shared_ptr<TreeChildrenLoad> _load)
+        : load(std::move(_load)), lastSent(std::chrono::steady_clock::now())
+    {
+    }
+    bool operator()(const vector<string_view>& texts, TreeViewChildrenLoader childrenLoader) override
+    {
+        if (load->stop)
+            return false;
+        CHECK(texts.size() > 0, true, "Expecting at least one text for a child");
+        auto& child = batch.emplace_back();
+        child.texts.assign(texts.begin(), texts.end());
+        child.childrenLoader = std::move(childrenLoader);
+        if ((batch.size() >= ChildrenLoaderBatch) ||
+            (std::chrono::steady_clock::now() - lastSent >= ChildrenLoaderInterval))
+            Send(false);
+        return !load->stop;
+    }
+    void Send(bool finished)
+    {
+        std::scoped_lock lock(load->lock);
+        if (load->pending.empty())
+            load->pending.swap(batch);
+        else
+            std::move(batch.begin(), batch.end(), std::back_inserter(load->pending));
+        batch.clear();
+        load->finished = finished;
+        lastSent       = std::chrono::steady_clock::now();
+    }
+};
+
+bool TreeControlContext::StartChildrenLoad(const ItemHandle handle)
+{
+    auto it = items.find(handle);
+    CHECK(it != items.end(), false, "Invalid item handle: %llu", (unsigned long long) handle);
+    CHECK(it->second.childrenLoader, false, "Item has no children loader !");
+    StopChildrenLoad(it->second);
+
+    auto load         = std::make_shared<TreeChildrenLoad>();
+    load->placeholder = AddItem(handle, { "Loading ..." });
+    items.at(load->placeholder).type = TreeViewItem::Type::GrayedOut;
+    it->second.childrenLoad          = load;
+    loadingItems.push_back(handle);
+
+    // the loader may block (a slow source must not freeze the UI or the other background tasks) --> it is never
+    // waited for; it owns a reference to the load and the loader, and stops as soon as the item is folded
+    auto task = [load, loader = it->second.childrenLoader]()
+    {
+        TreeChildrenSender sender(load);
+        if (!load->stop)
+            loader(sender);
+        sender.Send(true);
+    };
+    if (Application::RunInBackground(task, true))
+    {
+        host->EnableFrameUpdates(); // the children are received on frame updates
+        return true;
+    }
+    task(); // no worker threads --> the children are loaded right away
+    ProcessLoadedChildren();
+    return true;
+}
+
+bool TreeControlContext::StopChildrenLoad(TreeItem& item)
+{
+    if (!item.childrenLoad)
+        return false;
+    item.childrenLoad->stop = true;
+    item.childrenLoad.reset();
+    std::erase(loadingItems, item.handle);
+    if (loadingItems.empty())
+        host->DisableFrameUpdates();
+    return true;
+}
+
+void TreeControlContext::StopAllChildrenLoads()
+{
+    for (const auto handle : loadingItems)
+    {
+        if (const auto it = items.find(handle); it != items.end())
+        {
+            it->second.childrenLoad->stop = true;
+            it->second.childrenLoad.reset();
+        }
+    }
+    loadingItems.clear();
+    host->DisableFrameUpdates();
+}
+
+bool TreeControlContext::ProcessLoadedChildren()
+{
+    vector<TreeChildrenLoad::Child> children;
+    bool changed = false;
+    for (size_t index = 0; index < loadingItems.size();)
+    {
+        auto& item      = items.at(loadingItems[index]);
+        const auto load = item.childrenLoad;
+        bool finished;
+        {
+            std::scoped_lock lock(load->lock);
+            children.swap(load->pending);
+            finished = load->finished;
+        }
+
+        if (!children.empty())
+        {
+            // new children are added in front of the placeholder (handles are consecutive)
+            const auto first = nextItemHandle;
+            const auto added = AddItems(
+                  item.handle,
+                  static_cast<uint32>(children.size()),
+                  [&children](uint32 childIndex, vector<string_view>& texts)
+                  {
+                      for (const auto& text : children[childIndex].texts)
+                          texts.emplace_back(text);
+                      return true;
+                  });
+            for (uint32 tr = 0; tr < added; tr++)
+            {
+                auto& child          = items.at(first + tr);
+                child.childrenLoader = std::move(children[tr].childrenLoader);
+                child.isExpandable   = child.childrenLoader != nullptr;
+            }
+            std::erase(item.children, load->placeholder);
+            item.children.push_back(load->placeholder);
+            children.clear();
+            changed = true;
+        }
+        if (!finished)
+        {
+            index++;
+            continue;
+        }
+
+        if (GetCurrentItemHandle() == load->placeholder)
+            SetCurrentItemHandle(item.handle);
+        std::erase(item.children, load->placeholder);
+        RemoveItem(load->placeholder);
+        item.childrenLoad.reset();
+        loadingItems.erase(loadingItems.begin() + index);
+        changed = true;
+    }
+    if (loadingItems.empty())
+        host->DisableFrameUpdates();
+    if (changed)
+    {
+        ProcessItemsToBeDrawn(InvalidItemHandle);
+        if (filter.searchText.Len() > 0 && filter.mode != TreeControlContext::FilterMode::None)
+        {
+            SearchItems();
+        }
+    }
+    return changed;
+}
+
 GenericRef TreeControlContext::GetItemDataAsPointer(ItemHandle handle) const
 {
     const auto it = items.find(handle);
@@ -1983,6 +2238,7 @@ ItemHandle TreeControlContext::AddItem(ItemHandle parent, std::initializer_list<
 
     items[nextItemHandle]              = { parent, nextItemHandle, std::move(cbvs) };
     items[nextItemHandle].isExpandable = isExpandable;
+    AddToSearchIndex(items[nextItemHandle]);
 
     if (parent == InvalidItemHandle)
     {
@@ -2006,6 +2262,53 @@ ItemHandle TreeControlContext::AddItem(ItemHandle parent, std::initializer_list<
     return items[nextItemHandle++].handle;
 }
 
+uint32 TreeControlContext::AddItems(ItemHandle parent, uint32 count, const ItemsGenerator& getItem)
+{
+    CHECK(getItem, 0, "Expecting a valid items generator !");
+    TreeItem* parentItem = nullptr;
+    if (parent != InvalidItemHandle)
+    {
+        auto it = items.find(parent);
+        CHECK(it != items.end(), 0, "Invalid parent handle: %u", parent);
+        parentItem = &it->second;
+    }
+    auto& siblings = parentItem ? parentItem->children : roots;
+    siblings.reserve(siblings.size() + count);
+
+    const auto wasEmpty = items.empty();
+    const auto first    = nextItemHandle;
+    vector<string_view> texts;
+    texts.reserve(Header.GetColumnsCount());
+    uint32 added = 0;
+    while ((added < count) && (getItem(added, texts)))
+    {
+        CHECK(texts.size() > 0, added, "Expecting at least one text for item #%u", added);
+        // handles are always increasing --> new items are inserted at the end of the map
+        auto& item  = items.emplace_hint(items.end(), nextItemHandle, TreeItem{})->second;
+        item.parent = parent;
+        item.handle = nextItemHandle;
+        item.depth  = parentItem ? parentItem->depth + 1 : 1;
+        item.values.resize(texts.size());
+        for (size_t tr = 0; tr < texts.size(); tr++)
+            item.values[tr].Set(u8string_view((const char8*) texts[tr].data(), texts[tr].size()));
+        AddToSearchIndex(item);
+        siblings.push_back(nextItemHandle++);
+        texts.clear();
+        added++;
+    }
+
+    // ordering and filtering are updated once for the entire batch (when the tree is painted)
+    if (added > 0)
+    {
+        if (parentItem)
+            parentItem->isExpandable = true;
+        if (wasEmpty)
+            SetCurrentItemHandle(first);
+        notProcessed = true;
+    }
+    return added;
+}
+
 void TreeControlContext::TriggerOnCurrentItemChanged()
 {
     if (handlers != nullptr)
@@ -711,7 +711,7 @@ Window::Window(const ConstString& caption, string_view layout, WindowFlags Flags
                                     // title, OneSpaceRightPadding, close
                                     // button(char),right_corner(1 char) = 10+szTitle (szTitle = min 2 chars)
     ASSERT(SetMargins(1, 1, 1, 1), "Failed to set margins !");
-    Members->Flags = GATTR_ENABLE | GATTR_VISIBLE | GATTR_TABSTOP | (uint32) Flags;
+    Members->Flags = GATTR_ENABLE | GATTR_VISIBLE | GATTR_TABSTOP | GATTR_OPAQUE | (uint32) Flags;
 
     Members->Maximized                       = false;
     Members->ResizeMoveMode                  = false;
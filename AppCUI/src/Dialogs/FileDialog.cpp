@@ -1,7 +1,11 @@
-#include "AppCUI.hpp"
+#include "Internal.hpp"
 
 #include <set>
 #include <stack>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace AppCUI
 {
@@ -13,28 +17,11 @@ using namespace std::literals;
 
 constexpr uint32 ALL_FILES_INDEX = 0xFFFFFFFFU;
 
-static void ConvertSizeToString(uint64 size, char result[32])
-{
-    result[31] = 0;
-    int poz    = 30;
-    int cnt    = 0;
-    do
-    {
-        result[poz--] = (size % 10) + '0';
-        cnt++;
-        size = size / 10;
-        if ((cnt == 3) && (poz > 0) && (size > 0))
-        {
-            result[poz--] = ',';
-            cnt           = 0;
-        }
-
-    } while ((size > 0) && (poz > 0));
-    while (poz >= 0)
-    {
-        result[poz--] = ' ';
-    }
-}
+constexpr size_t FILE_DIALOG_FIRST_BATCH        = 64;    // enough entries to fill the first screen
+constexpr size_t FILE_DIALOG_BATCH              = 4096;  // entries sent to the UI thread at once
+constexpr size_t FILE_DIALOG_SORT_WHILE_LOADING = 16384; // bigger listings are sorted once they are complete
+constexpr size_t FILE_DIALOG_CACHED_LISTINGS    = 16;
+constexpr auto FILE_DIALOG_FIRST_BATCH_WAIT     = 200ms;
 
 static uint32 __compute_hash__(const char16* start, const char16* end)
 {
@@ -76,6 +63,164 @@ static vector<u16string_view> splitSV(u16string_view strv, u16string_view delims
     return output;
 }
 
+struct FileDialogEntry
+{
+    std::u16string name;
+    std::string modified;
+    uint64 size;
+    uint32 extensionHash;
+    bool isDirectory;
+    bool failed;
+};
+struct FileDialogListing
+{
+    std::filesystem::path path;
+    std::filesystem::file_time_type lastWriteTime;
+    vector<FileDialogEntry> entries; // owned by the UI thread
+    vector<uint32> order;            // sorted order of the entries (once the enumeration is complete)
+
+    // shared with the enumeration thread
+    std::atomic<bool> stop;
+    std::mutex lock;
+    std::condition_variable received;
+    vector<FileDialogEntry> pending;
+    bool finished;
+    bool readError;
+
+    FileDialogListing(const std::filesystem::path& _path, std::filesystem::file_time_type _lastWriteTime)
+        : path(_path), lastWriteTime(_lastWriteTime), stop(false), finished(false), readError(false)
+    {
+    }
+};
+
+// complete listings of the last visited folders (most recently used first); a listing is valid as long as
+// the modification time of its folder did not change
+static vector<std::shared_ptr<FileDialogListing>> cachedListings;
+
+static std::shared_ptr<FileDialogListing> GetCachedListing(
+      const std::filesystem::path& path, std::filesystem::file_time_type lastWriteTime)
+{
+    for (auto it = cachedListings.begin(); it != cachedListings.end(); it++)
+    {
+        if ((*it)->path != path)
+            continue;
+        if ((*it)->lastWriteTime != lastWriteTime)
+        {
+            cachedListings.erase(it);
+            return nullptr;
+        }
+        std::rotate(cachedListings.begin(), it, it + 1);
+        return cachedListings.front();
+    }
+    return nullptr;
+}
+static void AddCachedListing(const std::shared_ptr<FileDialogListing>& listing)
+{
+    std::erase_if(cachedListings, [&](const auto& l) { return l->path == listing->path; });
+    if (cachedListings.size() >= FILE_DIALOG_CACHED_LISTINGS)
+        cachedListings.pop_back();
+    cachedListings.insert(cachedListings.begin(), listing);
+}
+
+static void ReadDirectoryEntry(const std::filesystem::directory_entry& fileEntry, FileDialogEntry& entry)
+{
+    std::error_code err;
+    AppCUI::OS::DateTime dt;
+
+    entry.name          = fileEntry.path().filename().u16string();
+    entry.size          = 0;
+    entry.extensionHash = 0;
+    entry.isDirectory   = fileEntry.is_directory(err);
+    entry.failed        = static_cast<bool>(err); // not really - maybe reparse point
+    if ((!entry.isDirectory) && (!entry.failed))
+    {
+        auto ext16          = fileEntry.path().extension().u16string();
+        auto ext16Start     = ext16.data();
+        const auto ext16End = ext16.data() + ext16.size();
+        if (ext16.length() > 1 && ext16[0] == '.')
+            ext16Start++;
+        entry.extensionHash = __compute_hash__(ext16Start, ext16End);
+        entry.size          = (uint64) fileEntry.file_size(err);
+        entry.failed        = static_cast<bool>(err);
+    }
+    dt.CreateFrom(fileEntry);
+    entry.modified = dt.GetStringRepresentation();
+}
+
+// same order as the one used by the file list (folders first, then names without case)
+static void SortListedEntries(FileDialogListing& listing)
+{
+    const auto& entries = listing.entries;
+    listing.order.resize(entries.size());
+    for (uint32 idx = 0; idx < (uint32) entries.size(); idx++)
+        listing.order[idx] = idx;
+    std::sort(
+          listing.order.begin(),
+          listing.order.end(),
+          [&entries](uint32 i1, uint32 i2)
+          {
+              const auto& e1 = entries[i1];
+              const auto& e2 = entries[i2];
+              const auto k1  = ((e1.isDirectory) && (!e1.failed)) ? 1 : 2;
+              const auto k2  = ((e2.isDirectory) && (!e2.failed)) ? 1 : 2;
+              if (k1 != k2)
+                  return k1 < k2;
+              const auto sz = std::min<>(e1.name.size(), e2.name.size());
+              for (size_t idx = 0; idx < sz; idx++)
+              {
+                  char16 c1 = e1.name[idx];
+                  char16 c2 = e2.name[idx];
+                  if ((c1 >= 'A') && (c1 <= 'Z'))
+                      c1 |= 0x20;
+                  if ((c2 >= 'A') && (c2 <= 'Z'))
+                      c2 |= 0x20;
+                  if (c1 != c2)
+                      return c1 < c2;
+              }
+              return e1.name.size() < e2.name.size();
+          });
+}
+
+// runs on its own thread --> the entries are sent to the UI thread in batches (a small one first, so that
+// the first screen is filled as soon as possible)
+static void EnumerateDirectory(std::shared_ptr<FileDialogListing> listing)
+{
+    vector<FileDialogEntry> batch;
+    auto batchSize = FILE_DIALOG_FIRST_BATCH;
+    auto sendBatch = [&](bool finished, bool readError)
+    {
+        std::scoped_lock lock(listing->lock);
+        if (listing->pending.empty())
+            listing->pending.swap(batch);
+        else
+            std::move(batch.begin(), batch.end(), std::back_inserter(listing->pending));
+        batch.clear();
+        listing->finished  = finished;
+        listing->readError = readError;
+        listing->received.notify_all();
+    };
+
+    std::error_code err;
+    auto it = std::filesystem::directory_iterator(listing->path, err);
+    for (; (!err) && (it != std::filesystem::directory_iterator()) && (!listing->stop); it.increment(err))
+    {
+        try
+        {
+            ReadDirectoryEntry(*it, batch.emplace_back());
+        }
+        catch (...)
+        {
+            batch.pop_back(); // the name can not be converted
+        }
+        if (batch.size() >= batchSize)
+        {
+            sendBatch(false, false);
+            batchSize = FILE_DIALOG_BATCH;
+        }
+    }
+    sendBatch(true, static_cast<bool>(err));
+}
+
 class FileDialogWindow : public Window
 {
   public:
@@ -84,8 +229,10 @@ class FileDialogWindow : public Window
           const ConstString& fileName,
           const ConstString& extensionsFilter,
           const std::filesystem::path& _path);
+    ~FileDialogWindow();
 
     bool OnEvent(Reference<Control> sender, Event eventType, int controlID) override;
+    bool OnFrameUpdate() override;
     std::filesystem::path GetResultedPath() const;
 
   protected:
@@ -105,8 +252,10 @@ class FileDialogWindow : public Window
     const std::set<uint32>* extFilter;
     std::filesystem::path resultedPath;
     std::filesystem::path currentPath;
+    std::shared_ptr<FileDialogListing> listing; // entries of the current path (might still be enumerated)
 
     bool openDialog;
+    bool enumerating;
 
     void LoadAllSpecialLocations();
     bool ProcessExtensionFilter(const ConstString& extensionsFilter);
@@ -116,6 +265,10 @@ class FileDialogWindow : public Window
 
     void UpdateCurrentPath(const std::filesystem::path& newPath);
     void ReloadCurrentPath();
+    void StartEnumeration();
+    void StopEnumeration();
+    void AddListedEntry(const FileDialogEntry& entry);
+    bool ProcessReceivedEntries();
 
     void ProcessTextFieldInput();
     void FileListItemClicked();
@@ -145,7 +298,8 @@ FileDialogWindow::FileDialogWindow(
       const ConstString& fileName,
       const ConstString& extensionsFilter,
       const std::filesystem::path& specifiedPath)
-    : Window(open ? "Open" : "Save", "w:120,h:40,d:c", WindowFlags::None), extFilter(nullptr), openDialog(open)
+    : Window(open ? "Open" : "Save", "w:120,h:40,d:c", WindowFlags::None), extFilter(nullptr), openDialog(open),
+      enumerating(false)
 {
     const std::filesystem::path initialPath = CanonizePath(specifiedPath.empty() ? "." : specifiedPath);
 
@@ -193,14 +347,11 @@ FileDialogWindow::FileDialogWindow(
             return 1;
         auto cindex = control->GetSortColumnIndex();
         if (cindex.has_value())
-        {
-            const auto& s1 = item1.GetText(cindex.value());
-            const auto& s2 = item2.GetText(cindex.value());
-            return s1.CompareWith(s2, true);
-        }
+            return item1.CompareWith(item2, cindex.value()); // sizes are compared as numbers
         // else --> no sortable column
         return 0;
     };
+    files->SetColumnType(1, ListViewColumnType::UInt64, NumericFormat(NumericFormatFlags::None, 10, 3, ','));
     files->Sort(0, SortDirection::Ascendent); // sort after the first column, ascendent
 
     lbName = Factory::Label::Create(this, "File &Name", "x:1,y:90%,w:10%");
@@ -224,6 +375,11 @@ FileDialogWindow::FileDialogWindow(
     txName->SetFocus();
 }
 
+FileDialogWindow::~FileDialogWindow()
+{
+    StopEnumeration();
+}
+
 void FileDialogWindow::LoadAllSpecialLocations()
 {
     SpecialFolderMap specialFoldersMap;
@@ -416,90 +572,138 @@ void FileDialogWindow::UpdateCurrentExtensionFilter()
     }
 }
 
-void FileDialogWindow::ReloadCurrentPath()
+void FileDialogWindow::AddListedEntry(const FileDialogEntry& entry)
 {
-    files->DeleteAllItems();
+    if ((!entry.failed) && (!entry.isDirectory) && (extFilter) && (!extFilter->contains(entry.extensionHash)))
+        return; // extension is filtered
 
-    if (currentPath != currentPath.root_path())
+    auto item = this->files->AddItem({ entry.name, "", entry.modified });
+    if (entry.failed)
     {
-        files->AddItem({ "..", "UP-DIR" }).SetData(0);
+        item.SetText(1, "Unknown");
+        item.SetType(ListViewItem::Type::ErrorInformation);
+        item.SetData(2);
+    }
+    else if (entry.isDirectory)
+    {
+        item.SetText(1, "Folder");
+        item.SetType(ListViewItem::Type::Highlighted);
+        item.SetData(1);
+    }
+    else
+    {
+        item.SetValue(1, entry.size); // formatted only when it is painted
+        item.SetType(ListViewItem::Type::GrayedOut);
+        item.SetData(2);
     }
+}
 
-    char size[32];
-    AppCUI::OS::DateTime dt;
-    try
+bool FileDialogWindow::ProcessReceivedEntries()
+{
+    if (!enumerating)
+        return false;
+    vector<FileDialogEntry> received;
+    bool finished, readError;
+    {
+        std::scoped_lock lock(listing->lock);
+        received.swap(listing->pending);
+        finished  = listing->finished;
+        readError = listing->readError;
+    }
+    if ((received.empty()) && (!finished))
+        return false;
+
+    const auto start = listing->entries.size();
+    std::move(received.begin(), received.end(), std::back_inserter(listing->entries));
+    if (finished)
     {
-        for (const auto& fileEntry : std::filesystem::directory_iterator(currentPath))
+        enumerating = false;
+        DisableFrameUpdates();
+        if (!readError)
         {
-            bool isDirectory = false;
-            bool failed      = false;
-            try
+            // sorting the entries directly is a lot faster than sorting the items of a big list view
+            SortListedEntries(*listing);
+            AddCachedListing(listing);
+            if (listing->entries.size() > FILE_DIALOG_SORT_WHILE_LOADING)
             {
-                isDirectory = fileEntry.is_directory();
-                if (isDirectory)
-                {
-                    Utils::String::Set(size, "Folder", 32, 6);
-                }
-            }
-            catch (...)
-            {
-                MessageBox::ShowError("Error", u"Unable to read location: "s + fileEntry.path().u16string());
-                Utils::String::Set(size, "Unknown", 32, 7);
-                failed = true; // not really - maybe reparse point
+                ReloadCurrentPath();
+                return true;
             }
+        }
+    }
+    for (auto idx = start; idx < listing->entries.size(); idx++)
+        AddListedEntry(listing->entries[idx]);
+    if (readError)
+    {
+        auto item = files->AddItem({ "Unable to read the rest of the folder" });
+        item.SetType(ListViewItem::Type::ErrorInformation);
+        item.SetData(3); // nothing to open
+    }
+    if ((finished) || (files->GetItemsCount() <= FILE_DIALOG_SORT_WHILE_LOADING))
+        files->Sort();
+    return true;
+}
 
-            if (isDirectory == false)
-            {
-                // check filter first
-                if (extFilter)
-                {
-                    // a filter is set - let's check the extention
-                    auto ext16          = fileEntry.path().extension().u16string();
-                    auto ext16Start     = ext16.data();
-                    const auto ext16End = ext16.data() + ext16.size();
-
-                    if (ext16.length() > 1 && ext16[0] == '.')
-                    {
-                        ext16Start++;
-                    }
-                    if (!extFilter->contains(__compute_hash__(ext16Start, ext16End)))
-                    {
-                        continue; // extension is filtered
-                    }
-                }
-
-                if (failed == false)
-                {
-                    ConvertSizeToString((uint64) fileEntry.file_size(), size);
-                }
-            }
+void FileDialogWindow::StartEnumeration()
+{
+    std::error_code err;
+    const auto lastWriteTime = std::filesystem::last_write_time(currentPath, err);
+    if (!err)
+    {
+        listing = GetCachedListing(currentPath, lastWriteTime);
+        if (listing)
+            return;
+    }
+    listing     = std::make_shared<FileDialogListing>(currentPath, lastWriteTime);
+    enumerating = true;
+    // a slow or hung network folder can block the enumeration --> the task is not waited for (it owns the listing)
+    if (!Application::RunInBackground([listing = listing]() { EnumerateDirectory(listing); }, true))
+    {
+        listing->finished  = true;
+        listing->readError = true;
+    }
+    EnableFrameUpdates(); // the rest of the entries are received on frame updates
 
-            dt.CreateFrom(fileEntry);
-            auto item =
-                  this->files->AddItem({ fileEntry.path().filename().u16string(), size, dt.GetStringRepresentation() });
+    // wait a little for the first screen of entries --> small folders are shown at once
+    std::unique_lock lock(listing->lock);
+    listing->received.wait_for(
+          lock, FILE_DIALOG_FIRST_BATCH_WAIT, [this] { return listing->finished || !listing->pending.empty(); });
+}
 
-            if (failed)
-            {
-                item.SetType(ListViewItem::Type::ErrorInformation);
-                item.SetData(2);
-            }
-            else if (isDirectory)
-            {
-                item.SetType(ListViewItem::Type::Highlighted);
-                item.SetData(1);
-            }
-            else
-            {
-                item.SetType(ListViewItem::Type::GrayedOut);
-                item.SetData(2);
-            }
-        }
+void FileDialogWindow::StopEnumeration()
+{
+    // the enumeration thread is not waited for (a slow or hung network folder must not freeze the UI) - it
+    // owns a reference to the listing and exits after the entry it currently reads
+    if (enumerating)
+        listing->stop = true;
+    enumerating = false;
+    listing.reset();
+    DisableFrameUpdates();
+}
+
+void FileDialogWindow::ReloadCurrentPath()
+{
+    files->DeleteAllItems();
+
+    if (currentPath != currentPath.root_path())
+    {
+        files->AddItem({ "..", "UP-DIR" }).SetData(0);
     }
-    catch (...)
+    if ((listing) && (!enumerating) && (listing->order.size() == listing->entries.size()) &&
+        (files->GetSortColumnIndex() == 0U) && (files->GetSortDirection() == SortDirection::Ascendent))
+    {
+        // complete listings are already sorted by name
+        for (auto idx : listing->order)
+            AddListedEntry(listing->entries[idx]);
+        return;
+    }
+    if (listing)
     {
-        MessageBox::ShowError("Error", u"Unable to read location: "s + currentPath.u16string());
+        for (const auto& entry : listing->entries)
+            AddListedEntry(entry);
+        if (ProcessReceivedEntries())
+            return;
     }
-
     files->Sort();
 }
 
@@ -536,11 +740,18 @@ void FileDialogWindow::UpdateCurrentPath(const std::filesystem::path& newPath)
         return;
     }
 
+    StopEnumeration();
     currentPath = CanonizePath(newPath);
     lbPath->SetText(currentPath.u16string());
+    StartEnumeration();
     ReloadCurrentPath();
 }
 
+bool FileDialogWindow::OnFrameUpdate()
+{
+    return ProcessReceivedEntries();
+}
+
 bool FileDialogWindow::OnEvent(Reference<Control> sender, Controls::Event eventType, int controlID)
 {
     switch (eventType)
@@ -173,13 +173,18 @@ void Canvas::SetTranslate(int offX, int offY)
 }
 void Canvas::DarkenScreen()
 {
-    Character* start = this->Characters;
-    Character* end   = this->Characters + (this->Width * this->Height);
-    while (start < end)
-    {
-        start->Color = ColorPair{ Color::Gray, Color::Black };
-        start++;
-    }
+    // keep the character codes and replace the colors (a masked store over the packed value)
+    Character codeMask, dark;
+    codeMask.PackedValue  = 0;
+    codeMask.Code         = 0xFFFF;
+    dark.Code             = 0;
+    dark.Color            = ColorPair{ Color::Gray, Color::Black };
+    const uint32 keepMask = codeMask.PackedValue;
+    const uint32 setBits  = dark.PackedValue;
+    const uint32 count    = this->Width * this->Height;
+    auto* cells           = reinterpret_cast<uint32*>(this->Characters);
+    for (uint32 idx = 0; idx < count; idx++)
+        cells[idx] = (cells[idx] & keepMask) | setBits;
 }
 bool Canvas::ClearEntireSurface(int character, ColorPair color)
 {
@@ -53,6 +53,42 @@ size_t CopyStringToCharBuffer(Character* dest, const T* source, size_t sourceCha
     }
     return dest - ch_start;
 }
+// UTF-8 characters are decoded directly into the buffer (a UTF-8 string never has less bytes than characters)
+static bool CopyUTF8StringToCharBuffer(
+      Character* dest, const char8* source, size_t sourceBytesCount, ColorPair col, size_t& charactersCount)
+{
+    const char8* end    = source + sourceBytesCount;
+    Character* ch_start = dest;
+    UnicodeChar uc;
+    while (source < end)
+    {
+        dest->Color = col;
+        if ((*source) < 0x80)
+        {
+            if (((*source) == '\r') || ((*source) == '\n'))
+            {
+                const auto pair = ((*source) == '\r') ? '\n' : '\r';
+                dest->Code      = NEW_LINE_CODE;
+                source++;
+                if ((source < end) && ((*source) == pair))
+                    source++;
+            }
+            else
+            {
+                dest->Code = (char16) (*source);
+                source++;
+            }
+            dest++;
+            continue;
+        }
+        CHECK(ConvertUTF8CharToUnicodeChar(source, end, uc), false, "Fail to convert unicode character !");
+        dest->Code = uc.Value;
+        dest++;
+        source += uc.Length;
+    }
+    charactersCount = dest - ch_start;
+    return true;
+}
 template <typename T>
 size_t CopyStringToCharBufferWidthHotKey(
       Character* dest, const T* source, size_t sourceCharactersCount, ColorPair col, uint32& hotKeyPos)
@@ -278,7 +314,6 @@ bool CharacterBuffer::Set(const CharacterBuffer& obj)
 bool CharacterBuffer::Add(const ConstString& text, ColorPair color)
 {
     ConstStringObject textObj(text);
-    LocalUnicodeStringBuilder<1024> ub;
 
     if (textObj.Length == 0)
         return true; // nothing to do
@@ -305,8 +340,10 @@ bool CharacterBuffer::Add(const ConstString& text, ColorPair color)
               this->Buffer + this->Count, (const char16*) textObj.Data, textObj.Length, color);
         break;
     case StringEncoding::UTF8:
-        CHECK(ub.Set(text), false, "Fail to convert UTF-8 to current internal format !");
-        sz = CopyStringToCharBuffer<char16>(this->Buffer + this->Count, ub.GetString(), ub.Len(), color);
+        CHECK(CopyUTF8StringToCharBuffer(
+                    this->Buffer + this->Count, (const char8*) textObj.Data, textObj.Length, color, sz),
+              false,
+              "Fail to convert UTF-8 to current internal format !");
         break;
     default:
         RETURNERROR(false, "Unknwon string encoding type: %d", textObj.Encoding);
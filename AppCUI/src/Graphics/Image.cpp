@@ -227,10 +227,13 @@ Pixel Image::ComputeSquareAverageColor(uint32 x, uint32 y, uint32 sz) const
     const auto result_b      = sum_b / totalPixesl;
     return Pixel(result_r, result_g, result_b);
 }
-bool Image::Load(const std::filesystem::path& path)
+bool Image::Load(const std::filesystem::path& path, ImageScaleMethod scale)
 {
-    auto buf = OS::File::ReadContent(path);
-    return Create((const uint8*) buf.GetData(), (uint32) buf.GetLength());
+    // the file is mapped (not read) --> only the decoded (and scaled) image is kept in memory
+    OS::MappedFile f;
+    CHECK(f.OpenRead(path), false, "Fail to open: %s", path.string().c_str());
+    CHECK(f.GetSize() <= 0xFFFFFFFF, false, "File %s is too large (more than 4GB)", path.string().c_str());
+    return Create(f.GetData(), (uint32) f.GetSize(), scale);
 }
 bool Image::CreateFromDIB(const uint8* imageBuffer, uint32 size, bool isIcon)
 {
@@ -238,23 +241,93 @@ bool Image::CreateFromDIB(const uint8* imageBuffer, uint32 size, bool isIcon)
     CHECK(imageBuffer, false, "Expecting a valid (non-null) buffer !");
     return LoadDIBToImage(*this, imageBuffer, size, isIcon);
 }
-bool Image::Create(const uint8* imageBuffer, uint32 size)
+bool Image::Create(const uint8* imageBuffer, uint32 size, ImageScaleMethod scale)
 {
     CHECK(size > 4, false, "Invalid size (expecting at least 4 bytes)");
     CHECK(imageBuffer, false, "Expecting a valid (non-null) buffer !");
+    const auto rap = static_cast<uint32>(scale);
+    CHECK((rap >= 1) && (rap <= 20), false, "Invalid scale enum value");
     uint32 magic32 = *(const uint32*) imageBuffer;
     uint16 magic16 = *(const uint16*) imageBuffer;
 
     if (magic32 == IMAGE_PNG_MAGIC)
     {
-        return LoadPNGToImage(*this, imageBuffer, size);
+        // PNG images are scaled while they are decoded
+        return LoadPNGToImage(*this, imageBuffer, size, rap);
     }
     if (magic16 == IMAGE_BMP_MAGIC)
     {
-        return LoadBMPToImage(*this, imageBuffer, size);
+        CHECK(LoadBMPToImage(*this, imageBuffer, size), false, "");
+        if (rap == 1)
+            return true;
+        Image source(std::move(*this));
+        ImageDownscaler downscaler(*this);
+        CHECK(downscaler.Create(source.width, source.height, rap), false, "");
+        for (uint32 y = 0; y < source.height; y++)
+            downscaler.AddRow(source.pixels + (size_t) y * (size_t) source.width);
+        return true;
     }
 
     // unknwon type
     RETURNERROR(false, "Unknwon image type --> unable to identify magic ! (0x%08X)", magic32);
 }
+
+bool ImageDownscaler::Create(uint32 width, uint32 height, uint32 scaleFactor)
+{
+    CHECK((scaleFactor >= 1) && (scaleFactor <= 20), false, "Invalid scale factor: %u", scaleFactor);
+    CHECK((width > 0) && (height > 0), false, "Invalid image size: %ux%u", width, height);
+    const auto w = (width + scaleFactor - 1) / scaleFactor;
+    const auto h = (height + scaleFactor - 1) / scaleFactor;
+    CHECK(img.Create(w, h), false, "Fail to create a %ux%u size image", w, h);
+    if (scaleFactor > 1)
+    {
+        sums.reset(new uint32[(size_t) w * 3]);
+        memset(sums.get(), 0, sizeof(uint32) * (size_t) w * 3);
+    }
+    sourceWidth  = width;
+    sourceHeight = height;
+    factor       = scaleFactor;
+    sourceY      = 0;
+    return true;
+}
+void ImageDownscaler::AddRow(const Pixel* row)
+{
+    if (IsComplete())
+        return;
+    if (factor == 1)
+    {
+        memcpy(img.GetPixelsBuffer() + (size_t) sourceY * (size_t) sourceWidth, row, sourceWidth * sizeof(Pixel));
+        sourceY++;
+        return;
+    }
+    auto* s = sums.get();
+    for (uint32 x = 0; x < sourceWidth; s += 3)
+    {
+        const auto e = std::min<>(x + factor, sourceWidth);
+        for (; x < e; x++)
+        {
+            s[0] += row[x].Red;
+            s[1] += row[x].Green;
+            s[2] += row[x].Blue;
+        }
+    }
+    sourceY++;
+    if ((sourceY % factor) == 0)
+        FlushBlockRow(factor);
+    else if (sourceY == sourceHeight)
+        FlushBlockRow(sourceY % factor); // last (incomplete) block row
+}
+void ImageDownscaler::FlushBlockRow(uint32 rowsInBlock)
+{
+    const auto w = img.GetWidth();
+    auto* p      = img.GetPixelsBuffer() + (size_t) ((sourceY - 1) / factor) * (size_t) w;
+    auto* s      = sums.get();
+    for (uint32 x = 0; x < w; x++, p++, s += 3)
+    {
+        const auto columns = std::min<>(factor, sourceWidth - x * factor);
+        const auto total   = columns * rowsInBlock;
+        *p                 = Pixel(s[0] / total, s[1] / total, s[2] / total);
+    }
+    memset(sums.get(), 0, sizeof(uint32) * (size_t) w * 3);
+}
 } // namespace AppCUI::Graphics
@@ -6,8 +6,34 @@ namespace AppCUI
 {
 namespace Graphics
 {
+    // Builds an image that is 'factor' times smaller than the source, one source row at a time.
+    // Every resulting pixel is the average of a factor x factor block (a box filter), the same value
+    // Image::ComputeSquareAverageColor would return for that block.
+    class ImageDownscaler
+    {
+        Image& img;
+        std::unique_ptr<uint32[]> sums; // (red, green, blue) sum for every column of the resulting image
+        uint32 sourceWidth;
+        uint32 sourceHeight;
+        uint32 factor;
+        uint32 sourceY;
+
+        void FlushBlockRow(uint32 rowsInBlock);
+
+      public:
+        ImageDownscaler(Image& image) : img(image), sourceWidth(0), sourceHeight(0), factor(1), sourceY(0)
+        {
+        }
+        bool Create(uint32 width, uint32 height, uint32 scaleFactor);
+        void AddRow(const Pixel* row);
+        inline bool IsComplete() const
+        {
+            return sourceY >= sourceHeight;
+        }
+    };
+
     bool LoadDIBToImage(Image& img, const uint8* buffer, uint32 size, bool isIcon);
     bool LoadBMPToImage(Image& img, const uint8* buffer, uint32 size);
-    bool LoadPNGToImage(Image& img, const uint8* buffer, uint32 size);
+    bool LoadPNGToImage(Image& img, const uint8* buffer, uint32 size, uint32 scaleFactor);
 } // namespace Graphics
 } // namespace AppCUI
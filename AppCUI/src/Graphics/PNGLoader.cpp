@@ -1,22 +1,107 @@
 #include "ImageLoader.hpp"
 #include <libpng16/png.h>
+#include <csetjmp>
 
 namespace AppCUI::Graphics
 {
-bool LoadPNGToImage(Image& img, const uint8* imageBuffer, uint32 size)
+struct PNGMemoryReader
 {
-    /* Initialize the 'png_image' structure. */
-    png_image image{ .version = PNG_IMAGE_VERSION }; /* The control structure used by libpng */
+    const uint8* data;
+    size_t size;
+    size_t pos;
+};
+struct PNGDecoder
+{
+    png_structp png;
+    png_infop info;
+    PNGMemoryReader reader;
+    std::unique_ptr<Pixel[]> rows; // one row (or the entire image for interlaced PNGs)
+
+    PNGDecoder() : png(nullptr), info(nullptr), reader{ nullptr, 0, 0 }
+    {
+    }
+    ~PNGDecoder()
+    {
+        if (png)
+            png_destroy_read_struct(&png, info ? &info : nullptr, nullptr);
+    }
+};
+
+void PNG_ReadFromMemory(png_structp png, png_bytep output, png_size_t length)
+{
+    auto* reader = static_cast<PNGMemoryReader*>(png_get_io_ptr(png));
+    if (length > reader->size - reader->pos)
+        png_error(png, "Premature end of PNG buffer");
+    memcpy(output, reader->data + reader->pos, length);
+    reader->pos += length;
+}
+void PNG_OnError(png_structp png, png_const_charp message)
+{
+    LOG_ERROR("PNG decoding error: %s", message);
+    longjmp(png_jmpbuf(png), 1);
+}
+void PNG_OnWarning(png_structp, png_const_charp)
+{
+}
 
-    /* The first argument is the file to read: */
-    CHECK(png_image_begin_read_from_memory(&image, imageBuffer, size) != 0, false, "Failed to read PNG from memory!");
+// all objects with a destructor live in the caller --> it is safe to longjmp out of this function
+bool PNG_Decode(PNGDecoder& d, ImageDownscaler& downscaler, uint32 scaleFactor)
+{
+    if (setjmp(png_jmpbuf(d.png)))
+        return false;
 
-    std::unique_ptr<png_byte> buffer(new png_byte[PNG_IMAGE_SIZE(image)]);
-    CHECK(png_image_finish_read(&image, NULL, buffer.get(), 0, NULL) != 0, false, "");
+    png_set_read_fn(d.png, &d.reader, PNG_ReadFromMemory);
+    png_read_info(d.png, d.info);
 
-    CHECK(img.Create(image.width, image.height), false, "Fail to create a %ux%u size image", image.width, image.height);
-    memcpy(img.GetPixelsBuffer(), buffer.get(), ((size_t) image.width * (size_t) image.height) * sizeof(Pixel));
+    const auto width  = png_get_image_width(d.png, d.info);
+    const auto height = png_get_image_height(d.png, d.info);
+    // convert every format (palette, gray, 16 bits/channel, with or without alpha) to 8 bits BGRA (a Pixel)
+    png_set_expand(d.png);
+    png_set_strip_16(d.png);
+    png_set_gray_to_rgb(d.png);
+    png_set_bgr(d.png);
+    png_set_filler(d.png, 0xFF, PNG_FILLER_AFTER);
+    const auto passes = png_set_interlace_handling(d.png);
+    png_read_update_info(d.png, d.info);
+    CHECK(png_get_rowbytes(d.png, d.info) == (size_t) width * sizeof(Pixel), false, "Unexpected PNG row size");
 
+    CHECK(downscaler.Create(width, height, scaleFactor), false, "");
+    if (passes == 1)
+    {
+        // rows are decoded one by one and reduced on the fly
+        d.rows.reset(new Pixel[width]);
+        for (uint32 y = 0; y < height; y++)
+        {
+            png_read_row(d.png, reinterpret_cast<png_bytep>(d.rows.get()), nullptr);
+            downscaler.AddRow(d.rows.get());
+        }
+    }
+    else
+    {
+        // interlaced (Adam7) images complete their rows only in the last pass --> the full image is needed
+        d.rows.reset(new Pixel[(size_t) width * (size_t) height]);
+        for (auto pass = 0; pass < passes; pass++)
+        {
+            for (uint32 y = 0; y < height; y++)
+                png_read_row(d.png, reinterpret_cast<png_bytep>(d.rows.get() + (size_t) y * width), nullptr);
+        }
+        for (uint32 y = 0; y < height; y++)
+            downscaler.AddRow(d.rows.get() + (size_t) y * width);
+    }
+    png_read_end(d.png, nullptr);
+    return true;
+}
+
+bool LoadPNGToImage(Image& img, const uint8* imageBuffer, uint32 size, uint32 scaleFactor)
+{
+    PNGDecoder d;
+    ImageDownscaler downscaler(img);
+    d.reader = { imageBuffer, size, 0 };
+    d.png    = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, PNG_OnError, PNG_OnWarning);
+    CHECK(d.png, false, "Fail to create a PNG decoder !");
+    d.info = png_create_info_struct(d.png);
+    CHECK(d.info, false, "Fail to create a PNG info structure !");
+    CHECK(PNG_Decode(d, downscaler, scaleFactor), false, "Failed to read PNG from memory!");
     return true;
 }
 } // namespace AppCUI::Graphics
@@ -1,5 +1,6 @@
 #include "Internal.hpp"
 #include <chrono>
+#include <atomic>
 
 namespace AppCUI::Graphics
 {
@@ -10,6 +11,7 @@ using namespace std::chrono;
 constexpr uint32 PROGRESS_STATUS_PANEL_WIDTH  = 60;
 constexpr uint32 PROGRESS_STATUS_PANEL_HEIGHT = 8;
 constexpr uint32 MAX_PROGRESS_TIME_TEXT       = 35;
+constexpr auto PROGRESS_STATUS_POLL_INTERVAL  = 100ms; // how often the UI checks the progress of a background task
 
 // remove MessageBox definition that comes with Windows.h header
 #ifdef MessageBox
@@ -35,6 +37,82 @@ struct ProgressStatusData
     uint32 Progress;
 };
 
+class ProgressStatusTask : public ProgressStatus::Task
+{
+    std::atomic<uint64> value;
+    std::atomic<bool> canceled;
+    std::mutex lock;
+    std::condition_variable finishedCondition;
+    CharacterBuffer text;
+    bool textChanged;
+    bool started;
+    bool finished;
+
+  public:
+    ProgressStatusTask() : value(0), canceled(false), textChanged(false), started(false), finished(false)
+    {
+    }
+    void Update(uint64 newValue) override
+    {
+        value.store(newValue, std::memory_order_relaxed);
+    }
+    void Update(uint64 newValue, const ConstString& content) override
+    {
+        value.store(newValue, std::memory_order_relaxed);
+        std::scoped_lock guard(lock);
+        if (!text.Set(content))
+            text.Clear();
+        textChanged = true;
+    }
+    bool IsCanceled() const override
+    {
+        return canceled.load(std::memory_order_relaxed);
+    }
+    bool Start()
+    {
+        // a task that was canceled before a worker thread picked it up is dropped
+        std::scoped_lock guard(lock);
+        started = !canceled;
+        return started;
+    }
+    bool Cancel()
+    {
+        // returns false if the task did not start (it will never start)
+        std::scoped_lock guard(lock);
+        canceled = true;
+        return started;
+    }
+    uint64 GetValue() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+    bool GetText(CharacterBuffer& content)
+    {
+        std::scoped_lock guard(lock);
+        if (!textChanged)
+            return false;
+        textChanged = false;
+        return content.Set(text);
+    }
+    void Finish()
+    {
+        // notified under the lock --> the task object is still valid when the waiting thread wakes up
+        std::scoped_lock guard(lock);
+        finished = true;
+        finishedCondition.notify_all();
+    }
+    bool WaitFinished(milliseconds timeout)
+    {
+        std::unique_lock guard(lock);
+        return finishedCondition.wait_for(guard, timeout, [this] { return finished; });
+    }
+    void WaitFinished()
+    {
+        std::unique_lock guard(lock);
+        finishedCondition.wait(guard, [this] { return finished; });
+    }
+};
+
 static ProgressStatusData PSData = {};
 static bool progress_inited      = false;
 
@@ -321,4 +399,42 @@ bool ProgressStatus::Update(uint64 value)
 {
     return __ProgressStatus_Update(value, nullptr);
 }
-} // namespace AppCUI::Graphics
\ No newline at end of file
+bool ProgressStatus::Run(
+      const ConstString& Title, uint64 maxValue, const std::function<void(Task& task)>& task, Flags flags)
+{
+    CHECK(task, false, "Expecting a valid task !");
+    auto app = Application::GetApplication();
+    CHECK(app, false, "Application has not been initialized !");
+
+    // the state of the task is shared with the worker --> a task that was canceled before it started is dropped (the
+    // worker only finds out after this function returned)
+    auto progress = std::make_shared<ProgressStatusTask>();
+    auto work     = [progress, &task]()
+    {
+        if (!progress->Start())
+            return;
+        task(*progress);
+        progress->Finish();
+    };
+    CHECK(app->Workers.Run(work), false, "Fail to start the task !");
+
+    // the task only stores its progress --> the panel is painted (and the events are read) only on the UI thread
+    ProgressStatus::Init(Title, maxValue, flags);
+    CharacterBuffer text;
+    bool hasText = false;
+    while (!progress->WaitFinished(PROGRESS_STATUS_POLL_INTERVAL))
+    {
+        // the last text is sent every time (the status shows it only when it is refreshed)
+        hasText |= progress->GetText(text);
+        ConstString content = text;
+        if (__ProgressStatus_Update(progress->GetValue(), hasText ? &content : nullptr))
+        {
+            if (progress->Cancel())
+                progress->WaitFinished();
+            return false;
+        }
+    }
+    progress_inited = false;
+    return true;
+}
+} // namespace AppCUI::Graphics
@@ -1,4 +1,5 @@
 #include "Internal.hpp"
+#include <thread>
 namespace AppCUI::Graphics
 {
 using namespace Utils;
@@ -99,6 +100,84 @@ LineTypeChars* LineSpecialChars = nullptr;
 #define NO_TRANSPARENCY(color)                                                                                         \
     ((color.Foreground != Graphics::Color::Transparent) && (color.Background != Graphics::Color::Transparent))
 
+static_assert(sizeof(Character) == sizeof(uint32), "Character must fit in its 32 bits PackedValue");
+
+// A write expressed over Character::PackedValue: every cell becomes (cell & KeepMask) | SetBits.
+// Transparent colors and negative character codes only change the masks, so the loops that use it
+// have no branch per cell and can be vectorized by the compiler.
+struct PackedCharacterWrite
+{
+    uint32 KeepMask;
+    uint32 SetBits;
+
+    inline PackedCharacterWrite(int charCode, ColorPair color)
+    {
+        Character keep, set;
+        keep.PackedValue = 0xFFFFFFFF;
+        set.PackedValue  = 0;
+        if (charCode >= 0)
+        {
+            keep.Code = 0;
+            set.Code  = (char16) charCode;
+        }
+        if (color.Foreground != Graphics::Color::Transparent)
+        {
+            keep.Color.Foreground = static_cast<Graphics::Color>(0);
+            set.Color.Foreground  = color.Foreground;
+        }
+        if (color.Background != Graphics::Color::Transparent)
+        {
+            keep.Color.Background = static_cast<Graphics::Color>(0);
+            set.Color.Background  = color.Background;
+        }
+        KeepMask = keep.PackedValue;
+        SetBits  = set.PackedValue;
+    }
+};
+inline void FillPackedCharacters(Character* p, uint32 count, const PackedCharacterWrite& w)
+{
+    // masks are copied locally so that the compiler knows they are not changed by the stores
+    const uint32 keepMask = w.KeepMask;
+    const uint32 setBits  = w.SetBits;
+    // work over the packed values directly (a read through the union members is not vectorized)
+    auto* cells = reinterpret_cast<uint32*>(p);
+    if (keepMask == 0)
+    {
+        // opaque write (code and both colors) --> plain wide stores
+        for (uint32 idx = 0; idx < count; idx++)
+            cells[idx] = setBits;
+    }
+    else
+    {
+        // blended write --> masked stores
+        for (uint32 idx = 0; idx < count; idx++)
+            cells[idx] = (cells[idx] & keepMask) | setBits;
+    }
+}
+inline void CopyPackedCharacterCodes(Character* d, const Character* s, uint32 count, const PackedCharacterWrite& w)
+{
+    // the character code is taken from the source (w must be created with a valid character code)
+    // the colors are the ones from 'w' or from the destination (if transparent)
+    Character codeMask;
+    codeMask.PackedValue = 0;
+    codeMask.Code        = 0xFFFF;
+    const uint32 srcMask  = codeMask.PackedValue;
+    const uint32 keepMask = w.KeepMask & (~srcMask);
+    const uint32 setBits  = w.SetBits & (~srcMask);
+    auto* dest            = reinterpret_cast<uint32*>(d);
+    auto* src             = reinterpret_cast<const uint32*>(s);
+    if (keepMask == 0)
+    {
+        for (uint32 idx = 0; idx < count; idx++)
+            dest[idx] = (src[idx] & srcMask) | setBits;
+    }
+    else
+    {
+        for (uint32 idx = 0; idx < count; idx++)
+            dest[idx] = (src[idx] & srcMask) | (dest[idx] & keepMask) | setBits;
+    }
+}
+
 using namespace Graphics;
 
 #define TRANSLATE_X_COORDONATE(x) x += this->TranslateX;
@@ -477,22 +556,14 @@ bool Renderer::WriteSpecialCharacter(int x, int y, SpecialChars charID, ColorPai
 bool Renderer::_ClearEntireSurface(int character, ColorPair color)
 {
     CHECK_CANVAS_INITIALIZE;
-    Character* s = this->Characters;
-    Character* e = s + (this->Width * this->Height);
-    Character tmp;
-    tmp.Color = DefaultColorPair;
+    ColorPair c = DefaultColorPair;
     if (color.Background != Color::Transparent)
-        tmp.Color.Background = color.Background;
+        c.Background = color.Background;
     if (color.Foreground != Color::Transparent)
-        tmp.Color.Foreground = color.Foreground;
-    tmp.Code = 32;
-    if ((character >= 0) && (character <= 0xFFFF))
-        tmp.Code = (uint16) (character & 0xFFFF);
-    while (s < e)
-    {
-        s->PackedValue = tmp.PackedValue;
-        s++;
-    }
+        c.Foreground = color.Foreground;
+    if ((character < 0) || (character > 0xFFFF))
+        character = 32;
+    FillPackedCharacters(this->Characters, this->Width * this->Height, PackedCharacterWrite(character, c));
     return true;
 }
 bool Renderer::Clear(int charCode, ColorPair color)
@@ -529,25 +600,8 @@ bool Renderer::FillHorizontalLine(int left, int y, int right, int charCode, Colo
     right = std::min<>(right, Clip.Right);
     if (left > right)
         return false;
-    Character* p = this->OffsetRows[y] + left;
-    if ((charCode >= 0) && (NO_TRANSPARENCY(color)))
-    {
-        while (left <= right)
-        {
-            SET_CHARACTER(p, charCode, color);
-            left++;
-            p++;
-        }
-    }
-    else
-    {
-        while (left <= right)
-        {
-            SET_CHARACTER_EX(p, charCode, color);
-            left++;
-            p++;
-        }
-    }
+    FillPackedCharacters(
+          this->OffsetRows[y] + left, (uint32) (right + 1 - left), PackedCharacterWrite(charCode, color));
     return true;
 }
 bool Renderer::FillHorizontalLineWithSpecialChar(int left, int y, int right, SpecialChars charID, ColorPair color)
@@ -580,23 +634,14 @@ bool Renderer::FillVerticalLine(int x, int top, int bottom, int charCode, ColorP
     if (top > bottom)
         return false;
     Character* p = this->OffsetRows[top] + x;
-    if ((charCode >= 0) && (NO_TRANSPARENCY(color)))
-    {
-        while (top <= bottom)
-        {
-            SET_CHARACTER(p, charCode, color);
-            top++;
-            p += this->Width;
-        }
-    }
-    else
+    const PackedCharacterWrite w(charCode, color);
+    const uint32 keepMask = w.KeepMask;
+    const uint32 setBits  = w.SetBits;
+    while (top <= bottom)
     {
-        while (top <= bottom)
-        {
-            SET_CHARACTER_EX(p, charCode, color);
-            top++;
-            p += this->Width;
-        }
+        p->PackedValue = (p->PackedValue & keepMask) | setBits;
+        top++;
+        p += this->Width;
     }
     return true;
 }
@@ -631,31 +676,17 @@ bool Renderer::FillRect(int left, int top, int right, int bottom, int charCode,
 
     if ((left > right) || (top > bottom))
         return false;
-    Character* p;
-    Character** row = this->OffsetRows;
-    row += top;
-    if ((charCode >= 0) && (NO_TRANSPARENCY(color)))
+    const PackedCharacterWrite w(charCode, color);
+    const auto rowSize = (uint32) (right + 1 - left);
+    if (rowSize == this->Width)
     {
-        for (int y = top; y <= bottom; y++, row++)
-        {
-            p = (*row) + left;
-            for (int x = left; x <= right; x++, p++)
-            {
-                SET_CHARACTER(p, charCode, color);
-            }
-        }
-    }
-    else
-    {
-        for (int y = top; y <= bottom; y++, row++)
-        {
-            p = (*row) + left;
-            for (int x = left; x <= right; x++, p++)
-            {
-                SET_CHARACTER_EX(p, charCode, color);
-            }
-        }
+        // full width rows are contiguous in memory --> fill them all at once
+        FillPackedCharacters(this->OffsetRows[top], rowSize * (uint32) (bottom + 1 - top), w);
+        return true;
     }
+    Character** row = this->OffsetRows + top;
+    for (int y = top; y <= bottom; y++, row++)
+        FillPackedCharacters((*row) + left, rowSize, w);
     return true;
 }
 bool Renderer::DrawRect(int left, int top, int right, int bottom, ColorPair color, LineType lineType)
@@ -902,50 +933,58 @@ bool Renderer::DrawCanvas(int x, int y, const Canvas& canvas, const ColorPair ov
     }
     else
     {
-        // write character by character, changing the color
-        if ((overwriteColor.Background != Color::Transparent) && (overwriteColor.Foreground != Color::Transparent))
+        // copy row by row, keeping the character codes and changing the color
+        const PackedCharacterWrite w(0, overwriteColor);
+        while (canvas_height > 0)
         {
-            while (canvas_height > 0)
-            {
-                Character* d = this->OffsetRows[y] + x;
-                Character* s = canvas.OffsetRows[canvas_top] + canvas_left;
-                uint32 count = canvas_width;
-                while (count)
-                {
-                    SET_CHARACTER(d, s->Code, overwriteColor);
-                    d++;
-                    s++;
-                    count--;
-                }
-                canvas_top++;
-                y++;
-                canvas_height--;
-            }
+            CopyPackedCharacterCodes(
+                  this->OffsetRows[y] + x, canvas.OffsetRows[canvas_top] + canvas_left, (uint32) canvas_width, w);
+            canvas_top++;
+            y++;
+            canvas_height--;
         }
-        else
-        {
-            while (canvas_height > 0)
-            {
-                Character* d = this->OffsetRows[y] + x;
-                Character* s = canvas.OffsetRows[canvas_top] + canvas_left;
-                uint32 count = canvas_width;
-                while (count)
-                {
-                    SET_CHARACTER_EX(d, s->Code, overwriteColor);
-                    d++;
-                    s++;
-                    count--;
-                }
+    }
+    return true;
+}
 
-                canvas_top++;
-                y++;
-                canvas_height--;
-            }
+bool Renderer::DrawCanvas(int x, int y, TiledCanvas& canvas, const ColorPair overwriteColor)
+{
+    if ((!Clip.Visible) || (canvas.Width == 0) || (canvas.Height == 0))
+        return false;
+    // visible part of the surface (only the tiles that intersect it are copied)
+    const int left   = std::max<>(Clip.Left - (x + TranslateX), 0);
+    const int top    = std::max<>(Clip.Top - (y + TranslateY), 0);
+    const int right  = std::min<>(Clip.Right - (x + TranslateX), (int) canvas.Width - 1);
+    const int bottom = std::min<>(Clip.Bottom - (y + TranslateY), (int) canvas.Height - 1);
+    if ((right < left) || (bottom < top))
+        return false;
+    const auto fillColor = ((overwriteColor.Background == Color::Transparent) &&
+                            (overwriteColor.Foreground == Color::Transparent))
+                                 ? canvas.FillColor
+                                 : overwriteColor;
+    canvas.Frame++;
+    for (auto tileY = (uint32) top / canvas.TileHeight; tileY <= (uint32) bottom / canvas.TileHeight; tileY++)
+    {
+        for (auto tileX = (uint32) left / canvas.TileWidth; tileX <= (uint32) right / canvas.TileWidth; tileX++)
+        {
+            const auto tileLeft = x + (int) (tileX * canvas.TileWidth);
+            const auto tileTop  = y + (int) (tileY * canvas.TileHeight);
+            auto tile           = canvas.GetTile(tileX, tileY, false);
+            if (tile)
+                DrawCanvas(tileLeft, tileTop, *tile, overwriteColor);
+            else
+                FillRectSize(
+                      tileLeft,
+                      tileTop,
+                      std::min<>(canvas.TileWidth, canvas.Width - tileX * canvas.TileWidth),
+                      std::min<>(canvas.TileHeight, canvas.Height - tileY * canvas.TileHeight),
+                      canvas.FillCharacter,
+                      fillColor);
         }
     }
+    canvas.DiscardGeneratedTiles();
     return true;
 }
-
 bool Renderer::SetClipMargins(int leftMargin, int topMargin, int rightMargin, int bottomMargin)
 {
     if (!this->ClipHasBeenCopied)
@@ -1489,15 +1528,22 @@ void PixelToGrayScaleCharacter(Pixel colorRGB, ColorPair& c, SpecialChars& ch)
     else
         ch = SpecialChars::Block100;
 }
-void Paint_SmallBlocks(Renderer& r, const Graphics::Image& img, int x, int y, uint32 rap)
+// Every paint method draws the rows [startRow, endRow) of the resulting cells. Different rows are written
+// into different cells, so several bands of rows can be painted at the same time on different threads.
+using ImagePaintMethod =
+      void (*)(Renderer& r, const Image& img, int x, int y, uint32 rap, uint32 startRow, uint32 endRow);
+
+void Paint_SmallBlocks(
+      Renderer& r, const Graphics::Image& img, int x, int y, uint32 rap, uint32 startRow, uint32 endRow)
 {
     const auto w     = img.GetWidth();
-    const auto h     = img.GetHeight();
+    const auto h     = std::min<>(img.GetHeight(), endRow * rap * 2);
     const auto xStep = rap;
     const auto yStep = rap * 2;
     int px           = 0;
     ColorPair cp     = NoColorPair;
-    for (uint32 img_y = 0; img_y < h; img_y += yStep, y++)
+    y += (int) startRow;
+    for (uint32 img_y = startRow * yStep; img_y < h; img_y += yStep, y++)
     {
         px = x;
         for (uint32 img_x = 0; img_x < w; img_x += xStep, px++)
@@ -1520,14 +1566,16 @@ void Paint_SmallBlocks(Renderer& r, const Graphics::Image& img, int x, int y, ui
         }
     }
 }
-void Paint_LargeBlocks(Renderer& r, const Graphics::Image& img, int x, int y, uint32 rap)
+void Paint_LargeBlocks(
+      Renderer& r, const Graphics::Image& img, int x, int y, uint32 rap, uint32 startRow, uint32 endRow)
 {
     const auto w    = img.GetWidth();
-    const auto h    = img.GetHeight();
+    const auto h    = std::min<>(img.GetHeight(), endRow * rap);
     int px          = 0;
     ColorPair cp    = NoColorPair;
     SpecialChars sc = SpecialChars::Block100;
-    for (uint32 img_y = 0; img_y < h; img_y += rap, y++)
+    y += (int) startRow;
+    for (uint32 img_y = startRow * rap; img_y < h; img_y += rap, y++)
     {
         px = x;
         for (uint32 img_x = 0; img_x < w; img_x += rap, px += 2)
@@ -1542,14 +1590,15 @@ void Paint_LargeBlocks(Renderer& r, const Graphics::Image& img, int x, int y, ui
         }
     }
 }
-void Paint_GrayScale(Renderer& r, const Graphics::Image& img, int x, int y, uint32 rap)
+void Paint_GrayScale(Renderer& r, const Graphics::Image& img, int x, int y, uint32 rap, uint32 startRow, uint32 endRow)
 {
     const auto w    = img.GetWidth();
-    const auto h    = img.GetHeight();
+    const auto h    = std::min<>(img.GetHeight(), endRow * rap);
     int px          = 0;
     ColorPair cp    = NoColorPair;
     SpecialChars sc = SpecialChars::Block100;
-    for (uint32 img_y = 0; img_y < h; img_y += rap, y++)
+    y += (int) startRow;
+    for (uint32 img_y = startRow * rap; img_y < h; img_y += rap, y++)
     {
         px = x;
         for (uint32 img_x = 0; img_x < w; img_x += rap, px += 2)
@@ -1564,6 +1613,24 @@ void Paint_GrayScale(Renderer& r, const Graphics::Image& img, int x, int y, uint
         }
     }
 }
+void Paint_InBands(Renderer& r, const Graphics::Image& img, int x, int y, uint32 rap, uint32 rows, ImagePaintMethod fnc)
+{
+    // below this number of image pixels, handing the bands to other threads costs more than the conversion itself
+    constexpr uint64 MIN_PIXELS_PER_BAND = 0x10000;
+    const auto pixels                    = (uint64) img.GetWidth() * (uint64) img.GetHeight();
+    auto bands = std::min<uint64>({ (uint64) std::thread::hardware_concurrency(), pixels / MIN_PIXELS_PER_BAND, rows });
+    if (bands <= 1)
+    {
+        fnc(r, img, x, y, rap, 0, rows);
+        return;
+    }
+    const auto rowsPerBand = (uint32) ((rows + bands - 1) / bands);
+    auto paintBand = [&r, &img, x, y, rap, rows, rowsPerBand, fnc](uint32 band)
+    {
+        fnc(r, img, x, y, rap, band * rowsPerBand, std::min<>((band + 1) * rowsPerBand, rows));
+    };
+    Internal::RunInParallel((rows + rowsPerBand - 1) / rowsPerBand, paintBand);
+}
 Size Renderer::ComputeRenderingSize(const Image& img, ImageRenderingMethod method, ImageScaleMethod scale)
 {
     auto rap = static_cast<uint32>(scale);
@@ -1600,16 +1667,17 @@ bool Renderer::DrawImage(const Image& img, int x, int y, ImageRenderingMethod me
     // sanity check
     CHECK((rap >= 1) && (rap <= 20), false, "Invalid scale enum value");
 
+    const auto h = img.GetHeight();
     switch (method)
     {
     case ImageRenderingMethod::PixelTo16ColorsSmallBlock:
-        Paint_SmallBlocks(*this, img, x, y, rap);
+        Paint_InBands(*this, img, x, y, rap, (h + rap * 2 - 1) / (rap * 2), Paint_SmallBlocks);
         return true;
     case ImageRenderingMethod::PixelTo64ColorsLargeBlock:
-        Paint_LargeBlocks(*this, img, x, y, rap);
+        Paint_InBands(*this, img, x, y, rap, (h + rap - 1) / rap, Paint_LargeBlocks);
         return true;
     case ImageRenderingMethod::GrayScale:
-        Paint_GrayScale(*this, img, x, y, rap);
+        Paint_InBands(*this, img, x, y, rap, (h + rap - 1) / rap, Paint_GrayScale);
         return true;
     case ImageRenderingMethod::AsciiArt:
         NOT_IMPLEMENTED(false);
@@ -0,0 +1,114 @@
+#include "AppCUI.hpp"
+#include <algorithm>
+
+namespace AppCUI::Graphics
+{
+constexpr uint32 TILED_CANVAS_MAX_GENERATED_TILES = 1024; // tiles created by the renderer kept in memory
+
+TiledCanvas::TiledCanvas()
+    : Width(0), Height(0), TileWidth(0), TileHeight(0), GeneratedTiles(0), Frame(0), FillCharacter(' '),
+      FillColor(DefaultColorPair)
+{
+}
+bool TiledCanvas::Create(
+      uint32 width, uint32 height, int fillCharacter, ColorPair color, uint32 tileWidth, uint32 tileHeight)
+{
+    CHECK(width > 0, false, "Width must be greater than 0.");
+    CHECK(height > 0, false, "Height must be greater than 0.");
+    CHECK((tileWidth > 0) && (tileHeight > 0), false, "Invalid tile size (%u x %u)", tileWidth, tileHeight);
+    Invalidate();
+    this->Width         = width;
+    this->Height        = height;
+    this->TileWidth     = std::min<>(tileWidth, width);
+    this->TileHeight    = std::min<>(tileHeight, height);
+    this->FillCharacter = fillCharacter;
+    this->FillColor     = color;
+    return true;
+}
+void TiledCanvas::SetTileRenderer(TileRenderer renderer)
+{
+    this->renderTile = std::move(renderer);
+    Invalidate(); // tiles will be generated again when they become visible
+}
+void TiledCanvas::Invalidate()
+{
+    this->Tiles.clear();
+    this->GeneratedTiles = 0;
+}
+Canvas* TiledCanvas::GetTile(uint32 tileX, uint32 tileY, bool forWrite)
+{
+    const auto key = (((uint64) tileY) << 32) | tileX;
+    auto it        = Tiles.find(key);
+    if (it == Tiles.end())
+    {
+        if ((!forWrite) && (!renderTile))
+            return nullptr; // it will be shown as the fill character
+
+        const auto left   = tileX * TileWidth;
+        const auto top    = tileY * TileHeight;
+        const auto width  = std::min<>(TileWidth, Width - left);
+        const auto height = std::min<>(TileHeight, Height - top);
+        auto cells        = std::make_unique<Canvas>();
+        CHECK(cells->Create(width, height, FillCharacter, FillColor),
+              nullptr,
+              "Fail to allocate tile (%u,%u)",
+              tileX,
+              tileY);
+        if (renderTile)
+        {
+            cells->SetTranslate(-((int) left), -((int) top));
+            renderTile(*cells);
+        }
+        if (!forWrite)
+            GeneratedTiles++;
+        it = Tiles.emplace(key, Tile{ std::move(cells), Frame, !forWrite }).first;
+    }
+    else if ((forWrite) && (it->second.Generated))
+    {
+        it->second.Generated = false; // drawn over --> it has to be kept
+        GeneratedTiles--;
+    }
+    it->second.LastUsed = Frame;
+    // every user of the tile expects the coordinates of the entire surface
+    auto tile = it->second.Cells.get();
+    tile->ClearClip();
+    tile->SetTranslate(-((int) (tileX * TileWidth)), -((int) (tileY * TileHeight)));
+    return tile;
+}
+void TiledCanvas::DiscardGeneratedTiles()
+{
+    if (GeneratedTiles <= TILED_CANVAS_MAX_GENERATED_TILES)
+        return;
+    // the least recently painted tiles are dropped (half of the limit is kept to avoid doing this on every frame)
+    vector<std::pair<uint64, uint64>> candidates; // (last used, key)
+    for (const auto& [key, tile] : Tiles)
+        if ((tile.Generated) && (tile.LastUsed != Frame))
+            candidates.emplace_back(tile.LastUsed, key);
+    const auto count = std::min<size_t>(candidates.size(), GeneratedTiles - TILED_CANVAS_MAX_GENERATED_TILES / 2);
+    std::nth_element(candidates.begin(), candidates.begin() + count, candidates.end());
+    for (size_t idx = 0; idx < count; idx++)
+        Tiles.erase(candidates[idx].second);
+    GeneratedTiles -= (uint32) count;
+}
+bool TiledCanvas::Draw(int x, int y, uint32 width, uint32 height, const std::function<void(Canvas& tile)>& draw)
+{
+    CHECK(draw, false, "Expecting a valid draw callback !");
+    CHECK((Width > 0) && (Height > 0), false, "Tiled canvas was not created !");
+    const auto left   = std::max<int64>(x, 0);
+    const auto top    = std::max<int64>(y, 0);
+    const auto right  = std::min<int64>((int64) x + (int64) width, Width) - 1;
+    const auto bottom = std::min<int64>((int64) y + (int64) height, Height) - 1;
+    if ((right < left) || (bottom < top))
+        return false; // outside the surface
+    for (auto tileY = (uint32) (top / TileHeight); tileY <= (uint32) (bottom / TileHeight); tileY++)
+    {
+        for (auto tileX = (uint32) (left / TileWidth); tileX <= (uint32) (right / TileWidth); tileX++)
+        {
+            auto tile = GetTile(tileX, tileY, true);
+            CHECK(tile, false, "");
+            draw(*tile);
+        }
+    }
+    return true;
+}
+} // namespace AppCUI::Graphics
@@ -17,6 +17,12 @@
 
 #include <stdio.h>
 #include <iostream>
+#include <unordered_map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
 
 namespace AppCUI
 {
@@ -239,6 +245,75 @@ namespace Internal
         bool Load(AppCUI::Application::Config& config, const std::filesystem::path& inputFile);
     }; // namespace Config
 
+    struct OccludingControl
+    {
+        Controls::Control* Owner;
+        int Left, Top, Right, Bottom; // screen coordinates (right and bottom are exclusive)
+    };
+
+    // calls OnFrameUpdate only for the controls that subscribed to it. A timer wheel (one slot for every frame) makes
+    // a frame cost O(controls that are due) instead of O(all controls)
+    class FrameUpdateScheduler
+    {
+        static constexpr uint32 SLOTS_COUNT = 64;
+        struct Subscriber
+        {
+            Controls::Control* Control;
+            uint32 Interval; // frames
+            uint32 Rounds;   // complete turns of the wheel left until it is due
+        };
+        vector<Subscriber> Slots[SLOTS_COUNT];
+        std::unordered_map<Controls::Control*, uint32> Subscribed; // control --> slot
+        uint32 CurrentSlot;
+
+        void Schedule(Controls::Control* control, uint32 interval);
+
+      public:
+        FrameUpdateScheduler();
+        void Subscribe(Controls::Control* control, uint32 interval);
+        void Unsubscribe(Controls::Control* control);
+        bool Tick();
+        inline bool HasSubscribers() const
+        {
+            return !Subscribed.empty();
+        }
+    };
+
+    // threads are created when there is no idle one (up to the number of cores) and are kept for the next tasks.
+    // Tasks that may block (slow I/O) do not count against that limit and are not waited for when the pool is
+    // destroyed - their threads only use the shared state, so they can outlive the pool.
+    class WorkerThreadPool
+    {
+        struct Task
+        {
+            std::function<void()> Run;
+            bool MayBlock;
+        };
+        struct State
+        {
+            std::deque<Task> Tasks;
+            std::mutex Lock;
+            std::condition_variable TaskAdded, ThreadExited;
+            uint32 Threads, IdleThreads, BlockingTasks, BlockedThreads;
+            bool Stopped;
+        };
+        std::shared_ptr<State> state;
+
+        static void WorkerMain(std::shared_ptr<State> state);
+
+      public:
+        WorkerThreadPool();
+        ~WorkerThreadPool();
+        bool Run(std::function<void()> task, bool mayBlock = false);
+    };
+
+    // fnc(0) .. fnc(count - 1) are called on the worker pool and on the current thread, that also takes the indexes
+    // no worker got to (a busy pool, or no application at all, only makes it slower). Returns after all calls finished.
+    void RunInParallel(uint32 count, const std::function<void(uint32)>& fnc);
+    // starts a task that can run for a long time (it gets a thread of its own) - the future is ready after the task
+    // finished or was dropped (the application was closed before the task started)
+    std::future<void> RunLongTask(std::function<void()> task);
+
     struct ApplicationImpl
     {
         Application::Config config;
@@ -252,6 +327,8 @@ namespace Internal
         Controls::Desktop* AppDesktop;
         ToolTipController ToolTip;
         Application::CommandBar CommandBarWrapper;
+        FrameUpdateScheduler FrameUpdates;
+        WorkerThreadPool Workers;
 
         Controls::Control* ModalControlsStack[MAX_MODAL_CONTROLS_STACK];
         Controls::Control* MouseLockedControl;
@@ -259,6 +336,8 @@ namespace Internal
         Controls::Control* ExpandedControl;
         Controls::Menu* VisibleMenu;
         uint32 ModalControlsCount;
+        vector<OccludingControl> Occluders; // opaque controls painted after the one that is currently painted
+        vector<OccludingControl> OccludersInClip;
         LoopStatus loopStatus;
         uint32 RepaintStatus;
         MouseLockedObject mouseLockedObject;
@@ -315,6 +394,31 @@ namespace Internal
 
         void ArrangeWindows(Application::ArrangeWindowsMethod method);
     };
+
+    // waits for changes of a file (used to follow files that are appended to)
+    class FileChangesWatcher
+    {
+        std::filesystem::path path;
+#ifdef _WIN32
+        HANDLE handle;
+#else
+        int32 fd;
+        int32 watchID;
+#endif
+
+        bool Watch();
+
+      public:
+        FileChangesWatcher(const std::filesystem::path& filePath);
+        ~FileChangesWatcher();
+
+        // returns after the file was changed or after 'timeout' milliseconds
+        void Wait(uint32 timeout);
+    };
+
+    // 'id' identifies the file on disk (inode/device or file index/volume) --> a file that was replaced (for example
+    // after a log rotation) has a different id even if it has the same path
+    bool GetFileIdentity(const std::filesystem::path& filePath, uint64& id, uint64& size);
 } // namespace Internal
 namespace Application
 {
@@ -388,6 +492,38 @@ namespace Utils
             return items[index];
         }
     };
+
+    // maps every 3 consecutive characters (ASCII letters are case insensitive) to the items that contain them
+    class TrigramIndex
+    {
+        std::unordered_map<uint64, vector<uint32>> items; // sorted lists of items
+
+      public:
+        void Clear();
+        void Add(uint32 item, const Graphics::CharacterBuffer& text);
+        void Remove(uint32 item, const Graphics::CharacterBuffer& text);
+        // items that contain all the trigrams of the text (they still have to be verified)
+        // returns false if the text is too short to be searched with the index
+        bool GetCandidates(u16string_view text, vector<uint32>& result) const;
+    };
+
+    // prefix sums of a list of values (Fenwick tree) - sums, updates and searches by sum are O(log n)
+    class FenwickTree
+    {
+        vector<uint32> tree; // tree[i-1] = sum of the values from (i - lowbit(i), i]
+
+      public:
+        void Clear();
+        void Build(vector<uint32>&& values);
+        void Push(uint32 value);
+        void Add(uint32 index, int32 delta);
+        uint32 Sum(uint32 count) const; // sum of the first 'count' values
+        uint32 Find(uint32 sum) const;  // the largest count for which Sum(count) <= sum
+        inline uint32 Len() const
+        {
+            return static_cast<uint32>(tree.size());
+        }
+    };
 } // namespace Utils
 namespace Log
 {
@@ -1,4 +1,10 @@
 #include "../../Internal.hpp"
+#include <sys/mman.h>
+#include <poll.h>
+#include <thread>
+#if defined(__linux__)
+#    include <sys/inotify.h>
+#endif
 
 
 namespace AppCUI::OS
@@ -39,7 +45,7 @@ bool File::Create(const std::filesystem::path& path, bool overwriteExisting)
     Close();
     int fileId =
           open(path.string().c_str(),
-               overwriteExisting ? O_CREAT | O_RDWR | O_EXCL : O_CREAT | O_RDWR,
+               overwriteExisting ? O_CREAT | O_RDWR | O_TRUNC : O_CREAT | O_RDWR | O_EXCL,
                S_IRWXU | S_IRWXG | S_IRWXO);
     CHECK(fileId >= 0, false, "ERROR: %s", strerror(errno));
     this->FileID.fid = fileId;
@@ -112,4 +118,133 @@ void File::Close()
         this->FileID.fid = INVALID_FILE_HANDLE;
     }
 }
-}
\ No newline at end of file
+
+MappedFile::MappedFile() : data(nullptr), size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    this->Close();
+}
+
+bool MappedFile::OpenRead(const std::filesystem::path& path)
+{
+    Close();
+    int fileId = open(path.string().c_str(), O_RDONLY);
+    CHECK(fileId >= 0, false, "ERROR: %s", strerror(errno));
+    struct stat st;
+    if ((fstat(fileId, &st) != 0) || (st.st_size <= 0))
+    {
+        close(fileId);
+        RETURNERROR(false, "Empty file or unable to read the file size (%s)", path.string().c_str());
+    }
+    void* address = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fileId, 0);
+    // the mapping remains valid after the file descriptor is closed
+    close(fileId);
+    CHECK(address != MAP_FAILED, false, "ERROR: %s", strerror(errno));
+    madvise(address, (size_t) st.st_size, MADV_SEQUENTIAL);
+    this->data = static_cast<const uint8*>(address);
+    this->size = (uint64) st.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (this->data)
+    {
+        munmap(const_cast<uint8*>(this->data), (size_t) this->size);
+        this->data = nullptr;
+        this->size = 0;
+    }
+}
+} // namespace AppCUI::OS
+
+namespace AppCUI::Internal
+{
+constexpr int32 INVALID_WATCH_ID = -1;
+
+bool GetFileIdentity(const std::filesystem::path& filePath, uint64& id, uint64& size)
+{
+    struct stat st;
+    if (stat(filePath.string().c_str(), &st) != 0)
+        return false;
+    id   = (((uint64) st.st_dev) << 32) ^ ((uint64) st.st_ino);
+    size = (uint64) st.st_size;
+    return true;
+}
+
+#if defined(__linux__)
+FileChangesWatcher::FileChangesWatcher(const std::filesystem::path& filePath)
+    : path(filePath), fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)), watchID(INVALID_WATCH_ID)
+{
+    if (this->fd < 0)
+    {
+        LOG_ERROR("inotify_init1 failed: %s (the file will be checked periodically)", strerror(errno));
+        return;
+    }
+    Watch();
+}
+FileChangesWatcher::~FileChangesWatcher()
+{
+    if (this->fd >= 0)
+        close(this->fd);
+}
+bool FileChangesWatcher::Watch()
+{
+    if (this->watchID != INVALID_WATCH_ID)
+        inotify_rm_watch(this->fd, this->watchID);
+    // a file that is moved or deleted (log rotation) is watched again once it is re-created
+    this->watchID = inotify_add_watch(
+          this->fd,
+          this->path.string().c_str(),
+          IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF);
+    return this->watchID != INVALID_WATCH_ID;
+}
+void FileChangesWatcher::Wait(uint32 timeout)
+{
+    if ((this->fd < 0) || ((this->watchID == INVALID_WATCH_ID) && (!Watch())))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+        return;
+    }
+    pollfd pfd;
+    pfd.fd     = this->fd;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, (int) timeout) <= 0)
+        return;
+    // all pending events are consumed (the caller checks the file size anyway)
+    alignas(inotify_event) char buffer[4096];
+    bool watchAgain = false;
+    ssize_t sz;
+    while ((sz = read(this->fd, buffer, sizeof(buffer))) > 0)
+    {
+        for (ssize_t ofs = 0; ofs < sz;)
+        {
+            const auto* e = reinterpret_cast<const inotify_event*>(buffer + ofs);
+            watchAgain |= (e->mask & (IN_MOVE_SELF | IN_DELETE_SELF | IN_IGNORED)) != 0;
+            ofs += (ssize_t) (sizeof(inotify_event) + e->len);
+        }
+    }
+    if (watchAgain)
+        Watch();
+}
+#else
+// no change notifications --> the file is checked after every timeout
+FileChangesWatcher::FileChangesWatcher(const std::filesystem::path& filePath)
+    : path(filePath), fd(-1), watchID(INVALID_WATCH_ID)
+{
+}
+FileChangesWatcher::~FileChangesWatcher()
+{
+}
+bool FileChangesWatcher::Watch()
+{
+    return false;
+}
+void FileChangesWatcher::Wait(uint32 timeout)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+}
+#endif
+} // namespace AppCUI::Internal
@@ -213,6 +213,121 @@ void File::Close()
         FileID.Handle = INVALID_HANDLE_VALUE;
     }
 }
+
+MappedFile::MappedFile() : data(nullptr), size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::OpenRead(const std::filesystem::path& filePath)
+{
+    Close();
+
+    // sanitize -> https://docs.microsoft.com/en-us/windows/win32/fileio/maximum-file-path-limitation?tabs=powershell
+    auto path      = filePath.u16string();
+    auto u16svPath = std::u16string_view{ path.data(), path.size() };
+
+    LocalUnicodeStringBuilder<2048> longPath;
+    if (u16svPath.size() >= MAX_PATH && u16svPath.starts_with(u"\\") == false && u16svPath.starts_with(u"\?") == false)
+    {
+        std::replace(path.begin(), path.end(), L'/', L'\\');
+
+        CHECK(longPath.Add(longPathPrefix), false, "");
+        CHECK(longPath.Add(path), false, "");
+        CHECK(longPath.AddChar(u'\0'), false, "");
+        u16svPath = longPath.ToStringView();
+    }
+
+    HANDLE hFile = CreateFileW(
+          (LPCWSTR) u16svPath.data(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+    CHECK(hFile != INVALID_HANDLE_VALUE,
+          false,
+          "Fail to open: %s ==> Error code: %d",
+          filePath.string().c_str(),
+          GetLastError());
+
+    LARGE_INTEGER fileSize;
+    if ((!GetFileSizeEx(hFile, &fileSize)) || (fileSize.QuadPart <= 0))
+    {
+        CloseHandle(hFile);
+        RETURNERROR(false, "Empty file or unable to read the file size (%s)", filePath.string().c_str());
+    }
+    HANDLE hMapping = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(hFile);
+    CHECK(hMapping != NULL, false, "CreateFileMapping failed with code: %d", GetLastError());
+    // the view keeps the mapping object alive --> the handle can be closed right away
+    auto address = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(hMapping);
+    CHECK(address != NULL, false, "MapViewOfFile failed with code: %d", GetLastError());
+
+    this->data = static_cast<const uint8*>(address);
+    this->size = (uint64) fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (this->data)
+    {
+        UnmapViewOfFile(this->data);
+        this->data = nullptr;
+        this->size = 0;
+    }
+}
+
+bool Internal::GetFileIdentity(const std::filesystem::path& filePath, uint64& id, uint64& size)
+{
+    // only the attributes are read --> the file can be opened even if it is written by another process
+    HANDLE hFile = CreateFileW(
+          filePath.c_str(),
+          FILE_READ_ATTRIBUTES,
+          FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+          NULL,
+          OPEN_EXISTING,
+          0,
+          NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return false;
+    BY_HANDLE_FILE_INFORMATION info;
+    const auto result = GetFileInformationByHandle(hFile, &info);
+    CloseHandle(hFile);
+    if (!result)
+        return false;
+    id   = ((((uint64) info.nFileIndexHigh) << 32) | info.nFileIndexLow) ^ (((uint64) info.dwVolumeSerialNumber) << 32);
+    size = (((uint64) info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    return true;
+}
+Internal::FileChangesWatcher::FileChangesWatcher(const std::filesystem::path& filePath)
+    : path(filePath), handle(INVALID_HANDLE_VALUE)
+{
+    Watch();
+}
+Internal::FileChangesWatcher::~FileChangesWatcher()
+{
+    if (this->handle != INVALID_HANDLE_VALUE)
+        FindCloseChangeNotification(this->handle);
+}
+bool Internal::FileChangesWatcher::Watch()
+{
+    // notifications are available only for folders --> the parent folder is watched for size/write changes
+    this->handle = FindFirstChangeNotificationW(
+          this->path.parent_path().c_str(), FALSE, FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+    return this->handle != INVALID_HANDLE_VALUE;
+}
+void Internal::FileChangesWatcher::Wait(uint32 timeout)
+{
+    if (this->handle == INVALID_HANDLE_VALUE)
+    {
+        Sleep(timeout);
+        return;
+    }
+    if (WaitForSingleObject(this->handle, timeout) == WAIT_OBJECT_0)
+        FindNextChangeNotification(this->handle);
+}
 } // namespace AppCUI
 
 #undef VALIDATE_FILE_HANLDE
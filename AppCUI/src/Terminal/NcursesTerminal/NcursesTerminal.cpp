@@ -1,6 +1,7 @@
 #include "NcursesTerminal.hpp"
 #include <poll.h>
 #include <stdio.h>
+#include <termios.h>
 #if __APPLE__
 #    include <mach-o/dyld.h>
 #    include <sys/syslimits.h>
@@ -84,6 +85,10 @@ constexpr int KEY_LOCK_COMBO_MODE = ' ';
 constexpr int KEY_ESCAPE          = '\x1B'; // ESC key
 constexpr int KEY_TAB             = '\t';
 
+constexpr string_view BEGIN_SYNCHRONIZED_UPDATE = "\x1B[?2026h";
+constexpr string_view END_SYNCHRONIZED_UPDATE   = "\x1B[?2026l";
+constexpr int TERMINAL_QUERY_TIMEOUT            = 200; // milliseconds
+
 constexpr ColorPair DEFAULT_COMBO_COLOR{ Color::White, Color::DarkBlue };
 constexpr ColorPair PRESSED_COMBO_COLOR{ Color::Green, Color::Red };
 
@@ -119,6 +124,9 @@ bool NcursesTerminal::OnInit(const Application::InitializationData&)
         std::cout << "Your terminfo path is all set!\n";
     }
 
+    // has to be done before ncurses takes over the input
+    synchronizedOutput = QuerySynchronizedOutputSupport();
+
     if (!InitScreen())
         return false;
     if (!InitInput())
@@ -126,6 +134,57 @@ bool NcursesTerminal::OnInit(const Application::InitializationData&)
     return true;
 }
 
+// DECRQM for mode 2026 ("CSI ? 2026 $ p") --> "CSI ? 2026 ; <state> $ y" (1 = set, 2 = reset)
+// a primary device attributes query (answered by every terminal) follows it, so terminals that ignore
+// DECRQM do not make the initialization wait for the entire timeout
+bool NcursesTerminal::QuerySynchronizedOutputSupport()
+{
+    if ((!isatty(STDIN_FILENO)) || (!isatty(STDOUT_FILENO)))
+        return false;
+    termios originalSettings, querySettings;
+    CHECK(tcgetattr(STDIN_FILENO, &originalSettings) == 0, false, "Fail to read the terminal settings");
+    querySettings = originalSettings;
+    querySettings.c_lflag &= ~(ICANON | ECHO);
+    querySettings.c_cc[VMIN]  = 0;
+    querySettings.c_cc[VTIME] = 0;
+    CHECK(tcsetattr(STDIN_FILENO, TCSANOW, &querySettings) == 0, false, "Fail to change the terminal settings");
+
+    constexpr string_view query = "\x1B[?2026$p\x1B[c";
+    std::string response;
+    // the device attributes response ("CSI ? <attributes> c") is the last one
+    auto allReceived = [&response]() {
+        for (auto pos = response.find("\x1B[?"); pos != std::string::npos; pos = response.find("\x1B[?", pos + 1))
+        {
+            const auto end = response.find_first_not_of("0123456789;", pos + 3);
+            if ((end != std::string::npos) && (response[end] == 'c'))
+                return true;
+        }
+        return false;
+    };
+    if (WriteToTerminal(query))
+    {
+        pollfd readFD;
+        readFD.fd     = STDIN_FILENO;
+        readFD.events = POLLIN;
+        char buffer[256];
+        while ((!allReceived()) && (poll(&readFD, 1, TERMINAL_QUERY_TIMEOUT) > 0))
+        {
+            const auto bytesRead = read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (bytesRead <= 0)
+                break;
+            response.append(buffer, (size_t) bytesRead);
+        }
+    }
+    tcsetattr(STDIN_FILENO, TCSANOW, &originalSettings);
+
+    constexpr string_view reply = "\x1B[?2026;";
+    const auto pos              = response.find(reply);
+    if ((pos == std::string::npos) || (pos + reply.size() >= response.size()))
+        return false;
+    const auto state = response[pos + reply.size()];
+    return (state == '1') || (state == '2');
+}
+
 void NcursesTerminal::OnUnInit()
 {
     UnInitInput();
@@ -176,11 +235,32 @@ void NcursesTerminal::OnFlushToScreen()
         canvasState = nullptr;
     }
 
+    // only the characters that changed since the last flush are sent to ncurses
+    size_t exposedTop = 0, exposedBottom = 0;
+    auto changed          = false;
+    const auto fullRedraw = (lastFrameWidth != width) || (lastFrameHeight != height);
+    if (fullRedraw)
+    {
+        lastFrame.resize(width * height);
+        lastFrameWidth  = width;
+        lastFrameHeight = height;
+    }
+    else
+    {
+        ScrollUnchangedLines(charsBuffer, width, height, exposedTop, exposedBottom);
+    }
+
     for (size_t y = 0; y < height; y++)
     {
+        const auto redrawLine = fullRedraw || ((y >= exposedTop) && (y < exposedBottom));
         for (size_t x = 0; x < width; x++)
         {
             const Graphics::Character ch = charsBuffer[y * width + x];
+            auto& lastCh                 = lastFrame[y * width + x];
+            if ((!redrawLine) && (lastCh.PackedValue == ch.PackedValue))
+                continue;
+            lastCh  = ch;
+            changed = true;
             const cchar_t t              
             { 
                 .attr = 0, 
@@ -195,28 +275,147 @@ void NcursesTerminal::OnFlushToScreen()
         }
     }
 
-    move(lastCursorY, lastCursorX);
-    refresh();
+    // nothing is sent to the terminal for frames that are identical to the previous one
+    if (MoveCursor() || changed)
+        RefreshScreen();
 }
 
-void NcursesTerminal::OnFlushToScreen(const Graphics::Rect& /*r*/)
+void NcursesTerminal::Update()
 {
-    // No implementation for the moment, copy the entire screen
+    // the cursor is updated in the same refresh as the characters (OnUpdateCursor would refresh the screen again)
     OnFlushToScreen();
+    lastCursorX          = screenCanvas.GetCursorX();
+    lastCursorY          = screenCanvas.GetCursorY();
+    lastCursorVisibility = screenCanvas.GetCursorVisibility();
+}
+// returns true if the cursor is not where it was after the last update
+bool NcursesTerminal::MoveCursor()
+{
+    const auto visible = screenCanvas.GetCursorVisibility() ? 1 : 0;
+    // curs_set returns the previous visibility (and does nothing if it is the same)
+    const auto visibilityChanged = curs_set(visible) != visible;
+    if (!visible)
+        return visibilityChanged;
+    move(screenCanvas.GetCursorY(), screenCanvas.GetCursorX());
+    return visibilityChanged || (screenCanvas.GetCursorX() != lastCursorX) ||
+           (screenCanvas.GetCursorY() != lastCursorY);
+}
+// ncurses sends the frame with a single doupdate; with synchronized updates the terminal only displays it
+// once it was received entirely (no partially drawn frames)
+void NcursesTerminal::RefreshScreen()
+{
+    // ncurses has nothing buffered outside doupdate --> the markers can be written directly around it
+    if (synchronizedOutput)
+        synchronizedOutput = WriteToTerminal(BEGIN_SYNCHRONIZED_UPDATE);
+    refresh();
+    if (synchronizedOutput)
+        synchronizedOutput = WriteToTerminal(END_SYNCHRONIZED_UPDATE);
+}
+bool NcursesTerminal::WriteToTerminal(string_view text)
+{
+    while (!text.empty())
+    {
+        const auto written = write(STDOUT_FILENO, text.data(), text.size());
+        if ((written < 0) && (errno == EINTR))
+            continue;
+        CHECK(written > 0, false, "Fail to write to the terminal (errno = %d)", errno);
+        text.remove_prefix((size_t) written);
+    }
+    return true;
 }
 
-bool NcursesTerminal::OnUpdateCursor()
+// when a block of lines moved up or down since the last flush (a list that scrolls), the same block is scrolled in
+// ncurses as well --> with idlok enabled, ncurses moves it with a scroll region (DECSTBM) + scroll up/down sequences
+// instead of sending all of its characters again. Terminal scroll regions always span the entire width, so only
+// lines that are identical from one end of the screen to the other are considered.
+void NcursesTerminal::ScrollUnchangedLines(
+      const Character* charsBuffer, size_t width, size_t height, size_t& exposedTop, size_t& exposedBottom)
 {
-    if (screenCanvas.GetCursorVisibility())
+    constexpr size_t MIN_SCROLLED_LINES = 3;
+    if (height < MIN_SCROLLED_LINES * 2)
+        return;
+    auto lineHash = [width](const Character* line) {
+        uint64 hash = 0xcbf29ce484222325ULL;
+        for (size_t x = 0; x < width; x++)
+            hash = (hash ^ line[x].PackedValue) * 0x00000100000001B3ULL;
+        return hash;
+    };
+    std::vector<uint64> newLines(height), oldLines(height);
+    for (size_t y = 0; y < height; y++)
+    {
+        newLines[y] = lineHash(charsBuffer + y * width);
+        oldLines[y] = lineHash(lastFrame.data() + y * width);
+    }
+
+    // find the offset that moves most of the changed lines in place: newLines[y] == oldLines[y + offset]
+    const auto maxOffset = (int) (height / 2);
+    int bestOffset = 0, bestFirst = 0, bestLast = 0;
+    size_t bestCount = MIN_SCROLLED_LINES - 1;
+    for (auto offset = -maxOffset; offset <= maxOffset; offset++)
     {
-        curs_set(1);
-        move(screenCanvas.GetCursorY(), screenCanvas.GetCursorX());
+        if (offset == 0)
+            continue;
+        size_t count = 0;
+        int first = -1, last = -1;
+        for (int y = std::max<>(0, -offset); y < std::min<>((int) height, (int) height - offset); y++)
+        {
+            if ((newLines[y] != oldLines[y]) && (newLines[y] == oldLines[y + offset]))
+            {
+                count++;
+                first = first < 0 ? y : first;
+                last  = y;
+            }
+        }
+        if (count > bestCount)
+        {
+            bestCount  = count;
+            bestOffset = offset;
+            bestFirst  = first;
+            bestLast   = last;
+        }
+    }
+    if (bestOffset == 0)
+        return;
+
+    // the region contains both the old and the new position of the lines
+    const auto regionTop    = std::min<>(bestFirst, bestFirst + bestOffset);
+    const auto regionBottom = std::max<>(bestLast, bestLast + bestOffset);
+    scrollok(stdscr, TRUE);
+    wsetscrreg(stdscr, regionTop, regionBottom);
+    const auto scrolled = wscrl(stdscr, bestOffset) == OK;
+    wsetscrreg(stdscr, 0, (int) height - 1);
+    scrollok(stdscr, FALSE); // otherwise writing the last character of the screen would scroll it
+    CHECKRET(scrolled, "Fail to scroll lines %d-%d with %d lines", regionTop, regionBottom, bestOffset);
+
+    // keep the last frame in sync with what ncurses has now
+    const auto lineSize = width * sizeof(Character);
+    if (bestOffset > 0)
+    {
+        memmove(&lastFrame[regionTop * width],
+                &lastFrame[(regionTop + bestOffset) * width],
+                (regionBottom + 1 - regionTop - bestOffset) * lineSize);
+        exposedTop = regionBottom + 1 - bestOffset;
     }
     else
     {
-        curs_set(0);
+        memmove(&lastFrame[(regionTop - bestOffset) * width],
+                &lastFrame[regionTop * width],
+                (regionBottom + 1 - regionTop + bestOffset) * lineSize);
+        exposedTop = regionTop;
     }
-    refresh();
+    exposedBottom = exposedTop + std::abs(bestOffset);
+}
+
+void NcursesTerminal::OnFlushToScreen(const Graphics::Rect& /*r*/)
+{
+    // No implementation for the moment, copy the entire screen
+    OnFlushToScreen();
+}
+
+bool NcursesTerminal::OnUpdateCursor()
+{
+    MoveCursor();
+    RefreshScreen();
     return true;
 }
 
@@ -232,6 +431,12 @@ void NcursesTerminal::GetSystemEvent(Internal::SystemEvent& evnt)
     // poll for 30 milliseconds
     poll(&readFD, 1, 30);
 
+    // a frame update is requested at most every 33 ms (roughly 30 fps)
+    const auto pollTime = std::chrono::steady_clock::now();
+    evnt.updateFrames   = (pollTime - lastFramesUpdate) >= std::chrono::milliseconds(33);
+    if (evnt.updateFrames)
+        lastFramesUpdate = pollTime;
+
     int c = getch();
     if (c == ERR)
     {
@@ -303,6 +508,8 @@ bool NcursesTerminal::InitScreen()
     initscr();
     noecho();
     clear();
+    // allows ncurses to use the terminal scroll regions when lines are moved up or down
+    idlok(stdscr, TRUE);
 
     colors.Init();
 
@@ -328,6 +535,7 @@ bool NcursesTerminal::InitScreen()
 
 bool NcursesTerminal::InitInput()
 {
+    lastFramesUpdate = std::chrono::steady_clock::now();
     nodelay(stdscr, TRUE);
     keypad(stdscr, TRUE);
     cbreak();
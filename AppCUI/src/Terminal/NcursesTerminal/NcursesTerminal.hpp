@@ -2,6 +2,7 @@
 
 #include "../../Internal.hpp"
 #include <array>
+#include <chrono>
 #include <ncursesw/ncurses.h>
 
 /*
@@ -59,11 +60,16 @@ namespace Internal
         const static size_t COMBO_DLG_COL = 8;
         const static size_t COMBO_DLG_ROW = 3;
         Character* canvasState;
+        std::vector<Character> lastFrame; // what was sent to ncurses during the last flush
+        size_t lastFrameWidth  = 0;
+        size_t lastFrameHeight = 0;
         std::map<int, Input::Key> keyTranslationMatrix;
         ColorManager colors;
         TerminalMode mode;
         uint32 comboKeysMask   = 0;
         bool isComboModeLocked = false;
+        bool synchronizedOutput; // the terminal supports synchronized updates (DEC private mode 2026)
+        std::chrono::time_point<std::chrono::steady_clock> lastFramesUpdate;
 
       public:
         virtual bool OnInit(const Application::InitializationData& initData) override;
@@ -75,12 +81,20 @@ namespace Internal
         virtual bool IsEventAvailable() override;
         virtual void RestoreOriginalConsoleSettings() override;
         virtual bool HasSupportFor(Application::SpecialCharacterSetType type) override;
+        virtual void Update() override;
 
       private:
         bool InitScreen();
         bool InitInput();
+        bool QuerySynchronizedOutputSupport();
 
         void UnInitScreen();
+
+        bool MoveCursor();
+        void RefreshScreen();
+        bool WriteToTerminal(string_view text);
+        void ScrollUnchangedLines(
+              const Character* charsBuffer, size_t width, size_t height, size_t& exposedTop, size_t& exposedBottom);
         void UnInitInput();
 
         void HandleMouse(SystemEvent& evt, const int c);
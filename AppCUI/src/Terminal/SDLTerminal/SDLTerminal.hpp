@@ -25,7 +25,6 @@ namespace Internal
         TTF_Font* font;
         size_t charWidth;
         size_t charHeight;
-        bool autoRedraw;
 
         std::unordered_map<uint32, SDL_Texture*> characterCache;
 
@@ -170,22 +170,17 @@ void SDLTerminal::GetSystemEvent(Internal::SystemEvent& evnt)
     // wait 33 ms max for the next event, equates to roughly 30 fps
     if (!SDL_WaitEventTimeout(&e, 33))
     {
-        if (autoRedraw)
-        {
-            evnt.updateFrames = true;
-        }
+        evnt.updateFrames = true;
+        lastFramesUpdate  = std::chrono::high_resolution_clock::now();
         return;
     }
 
-    if (autoRedraw)
+    auto pollTime = std::chrono::high_resolution_clock::now();
+    auto diffMS   = std::chrono::duration_cast<std::chrono::milliseconds>(pollTime - lastFramesUpdate);
+    if (diffMS >= 33ms)
     {
-        auto pollTime = std::chrono::high_resolution_clock::now();
-        auto diffMS   = std::chrono::duration_cast<std::chrono::milliseconds>(pollTime - lastFramesUpdate);
-        if (diffMS >= 33ms)
-        {
-            evnt.updateFrames = true;
-            lastFramesUpdate  = pollTime;
-        }
+        evnt.updateFrames = true;
+        lastFramesUpdate  = pollTime;
     }
 
     switch (e.type)
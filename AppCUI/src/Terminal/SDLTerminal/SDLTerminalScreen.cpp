@@ -180,7 +180,6 @@ bool SDLTerminal::InitScreen(const InitializationData& initData)
           "Fail to create the original screen canvas of %d x %d size",
           widthInChars,
           heightInChars);
-    autoRedraw = (initData.Flags & InitializationFlags::EnableFPSMode) != InitializationFlags::None;
     return true;
 }
 
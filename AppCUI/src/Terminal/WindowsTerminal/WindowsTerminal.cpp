@@ -568,7 +568,8 @@ void WindowsTerminal::GetSystemEvent(Internal::SystemEvent& evnt)
 
     INPUT_RECORD ir;
     DWORD nrread;
-    if (this->fpsMode)
+    // without FPS mode the input is waited for (unless some controls requested frame updates)
+    if ((this->fpsMode) || (Application::GetApplication()->FrameUpdates.HasSubscribers()))
     {
         DWORD64 cTime = GetTickCount64();
         DWORD diff    = 33;
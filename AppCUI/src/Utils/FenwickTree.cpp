@@ -0,0 +1,62 @@
+#include "Internal.hpp"
+
+namespace AppCUI::Utils
+{
+static inline uint32 LowBit(uint32 value)
+{
+    return value & (0U - value);
+}
+
+void FenwickTree::Clear()
+{
+    tree.clear();
+}
+void FenwickTree::Build(vector<uint32>&& values)
+{
+    // every node adds itself to its parent --> O(n)
+    tree             = std::move(values);
+    const auto count = Len();
+    for (uint32 i = 1; i <= count; i++)
+    {
+        const auto parent = i + LowBit(i);
+        if (parent <= count)
+            tree[parent - 1] += tree[i - 1];
+    }
+}
+void FenwickTree::Push(uint32 value)
+{
+    // the new node covers (i - lowbit(i), i] --> the sums of the nodes below it are added to the value
+    const auto i = Len() + 1;
+    tree.push_back(value + Sum(i - 1) - Sum(i - LowBit(i)));
+}
+void FenwickTree::Add(uint32 index, int32 delta)
+{
+    const auto count = Len();
+    for (auto i = index + 1; i <= count; i += LowBit(i))
+        tree[i - 1] += static_cast<uint32>(delta);
+}
+uint32 FenwickTree::Sum(uint32 count) const
+{
+    uint32 sum = 0;
+    for (auto i = std::min<>(count, Len()); i > 0; i -= LowBit(i))
+        sum += tree[i - 1];
+    return sum;
+}
+uint32 FenwickTree::Find(uint32 sum) const
+{
+    const auto count = Len();
+    uint32 pos       = 0;
+    uint32 step      = 1;
+    while ((step << 1) <= count)
+        step <<= 1;
+    for (; step > 0; step >>= 1)
+    {
+        if ((pos + step <= count) && (tree[pos + step - 1] <= sum))
+        {
+            pos += step;
+            sum -= tree[pos - 1];
+        }
+    }
+    return pos;
+}
+} // namespace AppCUI::Utils
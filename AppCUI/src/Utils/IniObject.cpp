@@ -1,6 +1,6 @@
 #include "Internal.hpp"
 
-#include <unordered_map>
+#include <thread>
 
 using namespace AppCUI;
 using namespace Utils;
@@ -22,8 +22,7 @@ using BuffPtr = const uint8*;
 #define WRITE_INI_NUMERIC_VALUE                                                                                        \
     PREPARE_VALUE;                                                                                                     \
     NumericFormatter n;                                                                                                \
-    iniValue->KeyValue = n.ToDec(value);                                                                               \
-    iniValue->KeyValues.clear();
+    iniValue->SetValue(n.ToDec(value));
 
 #define VALIDATE_INITED(returnValue)                                                                                   \
     CHECK(Data, returnValue, "Parser object has not been created. Have you called one of the Crete... methods first ?");
@@ -152,29 +151,339 @@ namespace Ini
         ExpectingValue,
         ExpectingArray
     };
+    // a name or a value: either a view into the parsed buffer (not null terminated) or a null terminated copy that
+    // is stored in the StringArena of the object
+    struct Text
+    {
+        const char* Data;
+        uint32 Length;
+        bool Terminated;
+
+        Text() : Data(nullptr), Length(0), Terminated(false)
+        {
+        }
+        Text(BuffPtr start, BuffPtr end) : Data((const char*) start), Length((uint32) (end - start)), Terminated(false)
+        {
+        }
+        inline bool IsSet() const
+        {
+            return Data != nullptr;
+        }
+        inline operator string_view() const
+        {
+            if (Data)
+                return string_view(Data, Length);
+            return string_view("", 0);
+        }
+    };
+    // strings are never released individually (only all at once, when the object is cleared)
+    class StringArena
+    {
+        static constexpr size_t BLOCK_SIZE = 0x10000;
+
+        std::vector<unique_ptr<char[]>> blocks;
+        char* current;
+        size_t available;
+
+      public:
+        StringArena() : current(nullptr), available(0)
+        {
+        }
+        Text Add(string_view text)
+        {
+            const auto size = text.size() + 1;
+            char* p;
+            if (size > BLOCK_SIZE / 4)
+            {
+                // large strings get their own block (the current block can still be used for the small ones)
+                blocks.emplace_back(new char[size]);
+                p = blocks.back().get();
+            }
+            else
+            {
+                if (size > available)
+                {
+                    blocks.emplace_back(new char[BLOCK_SIZE]);
+                    current   = blocks.back().get();
+                    available = BLOCK_SIZE;
+                }
+                p = current;
+                current += size;
+                available -= size;
+            }
+            memcpy(p, text.data(), text.size());
+            p[text.size()] = 0;
+            Text result;
+            result.Data       = p;
+            result.Length     = (uint32) text.size();
+            result.Terminated = true;
+            return result;
+        }
+        void Clear()
+        {
+            blocks.clear();
+            current   = nullptr;
+            available = 0;
+        }
+    };
+    // open addressing (linear probing) table indexed by the FNV hash of a name
+    // T is a pointer like type and a null item marks an empty slot
+    template <typename T>
+    class HashTable
+    {
+      public:
+        struct Entry
+        {
+            uint64 Hash;
+            T Item;
+        };
+        class Iterator
+        {
+            Entry* entry;
+            Entry* last;
+
+            inline void SkipEmptySlots()
+            {
+                while ((entry < last) && (!entry->Item))
+                    entry++;
+            }
+
+          public:
+            Iterator(Entry* start, Entry* end) : entry(start), last(end)
+            {
+                SkipEmptySlots();
+            }
+            Iterator& operator++()
+            {
+                entry++;
+                SkipEmptySlots();
+                return *this;
+            }
+            bool operator!=(const Iterator& it) const
+            {
+                return entry != it.entry;
+            }
+            Entry& operator*() const
+            {
+                return *entry;
+            }
+            Entry* operator->() const
+            {
+                return entry;
+            }
+        };
+
+      private:
+        unique_ptr<Entry[]> entries;
+        uint32 capacity; // always a power of 2
+        uint32 shift;
+        uint32 count;
+
+        inline uint32 GetSlot(uint64 hash) const
+        {
+            // the low bits of a FNV hash are poorly distributed --> use the high bits of a fibonacci hash
+            return (uint32) ((hash * 0x9E3779B97F4A7C15ULL) >> shift);
+        }
+        void Resize(uint32 newCapacity)
+        {
+            auto oldEntries  = std::move(entries);
+            auto oldCapacity = capacity;
+            entries.reset(new Entry[newCapacity]());
+            capacity = newCapacity;
+            shift    = 64;
+            for (auto sz = newCapacity; sz > 1; sz >>= 1)
+                shift--;
+            for (uint32 idx = 0; idx < oldCapacity; idx++)
+            {
+                if (!oldEntries[idx].Item)
+                    continue;
+                auto slot = GetSlot(oldEntries[idx].Hash);
+                while (entries[slot].Item)
+                    slot = (slot + 1) & (capacity - 1);
+                entries[slot] = std::move(oldEntries[idx]);
+            }
+        }
+        Entry* FindEntry(uint64 hash) const
+        {
+            if (count == 0)
+                return nullptr;
+            auto slot = GetSlot(hash);
+            while (entries[slot].Item)
+            {
+                if (entries[slot].Hash == hash)
+                    return &entries[slot];
+                slot = (slot + 1) & (capacity - 1);
+            }
+            return nullptr;
+        }
+
+      public:
+        HashTable() : capacity(0), shift(64), count(0)
+        {
+        }
+        inline uint32 Size() const
+        {
+            return count;
+        }
+        inline bool Contains(uint64 hash) const
+        {
+            return FindEntry(hash) != nullptr;
+        }
+        inline T* Find(uint64 hash) const
+        {
+            auto entry = FindEntry(hash);
+            return entry ? &entry->Item : nullptr;
+        }
+        // the hash must not exist in the table (use Find first)
+        void Add(uint64 hash, T item)
+        {
+            // keep the load factor under 75%
+            if ((count + 1) * 4 > capacity * 3)
+                Resize(capacity ? capacity * 2 : 8);
+            auto slot = GetSlot(hash);
+            while (entries[slot].Item)
+                slot = (slot + 1) & (capacity - 1);
+            entries[slot].Hash = hash;
+            entries[slot].Item = std::move(item);
+            count++;
+        }
+        bool Erase(uint64 hash)
+        {
+            auto entry = FindEntry(hash);
+            if (!entry)
+                return false;
+            entry->Item = T();
+            // move back the entries that follow (until an empty slot) so that no search stops in the new hole
+            const auto mask = capacity - 1;
+            auto hole       = (uint32) (entry - entries.get());
+            auto idx        = hole;
+            while (true)
+            {
+                idx = (idx + 1) & mask;
+                if (!entries[idx].Item)
+                    break;
+                const auto home = GetSlot(entries[idx].Hash);
+                if (((idx - home) & mask) >= ((idx - hole) & mask))
+                {
+                    entries[hole] = std::move(entries[idx]);
+                    entries[idx].Item = T();
+                    hole              = idx;
+                }
+            }
+            count--;
+            return true;
+        }
+        void Clear()
+        {
+            entries.reset();
+            capacity = 0;
+            shift    = 64;
+            count    = 0;
+        }
+        inline Iterator begin() const
+        {
+            return Iterator(entries.get(), entries.get() + capacity);
+        }
+        inline Iterator end() const
+        {
+            return Iterator(entries.get() + capacity, entries.get() + capacity);
+        }
+    };
     struct Value
     {
-        std::string KeyName;
-        std::string KeyValue;
-        vector<std::string> KeyValues;
-        Value()
+        Text KeyName;
+        Text KeyValue;
+        vector<Text> KeyValues;
+        StringArena* Arena;
+
+        Value(StringArena* arena) : Arena(arena)
+        {
+        }
+        // a copy is made only the first time a C-string is requested for a value that was read from the buffer
+        const char* GetCString(Text& text)
+        {
+            if (!text.IsSet())
+                return "";
+            if (!text.Terminated)
+                text = Arena->Add(text);
+            return text.Data;
+        }
+        void SetValue(string_view value)
+        {
+            KeyValue = Arena->Add(value);
+            KeyValues.clear();
+        }
+        void SetArray()
+        {
+            KeyValue = Text();
+            KeyValues.clear();
+        }
+        inline void AddArrayValue(string_view value)
+        {
+            KeyValues.push_back(Arena->Add(value));
+        }
+    };
+    // values are allocated in fixed size blocks (an IniValue keeps a pointer to a Value --> it must never move)
+    class ValueStorage
+    {
+        static constexpr size_t BLOCK_SIZE = 256;
+
+        vector<vector<Value>> blocks;
+
+      public:
+        Value* Allocate(StringArena* arena)
+        {
+            if ((blocks.empty()) || (blocks.back().size() == blocks.back().capacity()))
+            {
+                blocks.emplace_back();
+                blocks.back().reserve(BLOCK_SIZE);
+            }
+            return &blocks.back().emplace_back(arena);
+        }
+        // takes the blocks of another storage (the values keep their addresses)
+        void Adopt(ValueStorage& storage)
+        {
+            for (auto& block : storage.blocks)
+                blocks.push_back(std::move(block));
+            storage.blocks.clear();
+        }
+        inline vector<vector<Value>>& GetBlocks()
         {
+            return blocks;
         }
-        Value(string_view keyName)
+        void Clear()
         {
-            KeyName = keyName;
+            blocks.clear();
         }
     };
     struct Section
     {
-        Utils::String Name;
-        std::unordered_map<uint64, Value> Keys;
-        Section()
+        Text Name;
+        HashTable<Value*> Keys;
+        ValueStorage* Storage;
+        StringArena* Arena;
+
+        Section(ValueStorage* storage, StringArena* arena) : Storage(storage), Arena(arena)
+        {
+        }
+        Section(ValueStorage* storage, StringArena* arena, string_view name)
+            : Name(arena->Add(name)), Storage(storage), Arena(arena)
+        {
+        }
+        // returns the existing value for a key or a new (empty) one
+        Value* GetOrCreateValue(uint64 hash)
         {
+            auto value = Keys.Find(hash);
+            if (value)
+                return *value;
+            auto newValue = Storage->Allocate(Arena);
+            Keys.Add(hash, newValue);
+            return newValue;
         }
-        Section(string_view name)
+        // the memory used by the removed values is released only when the entire object is cleared
+        void Clear()
         {
-            Name.Set(name.data(), (uint32) name.length());
+            Keys.Clear();
         }
     };
     struct Parser
@@ -182,16 +491,32 @@ namespace Ini
         BuffPtr start;
         BuffPtr end;
         BuffPtr current;
+        BuffPtr chunkEnd;
         ParseState state;
         std::string toStringBuffer;
 
-        std::unordered_map<uint64, unique_ptr<Ini::Section>> Sections;
+        StringArena Strings; // names and values that are not part of the parsed buffer
+        StringArena* Arena;  // the parser that parses a chunk in parallel uses the strings of the main one
+        ValueStorage Values;
+        unique_ptr<char[]> Content; // a copy of the parsed buffer (names and values point into it)
+        OS::MappedFile MappedContent; // zero-copy mode --> names and values point directly into the file
+
+        HashTable<unique_ptr<Ini::Section>> Sections;
         Section DefaultSection; // KeyValue entries that do not have a section name (writtem directly in the root)
         Section* CurrentSection;
         uint64 CurrentKeyHash;
         BuffPtr CurrentKeyNamePtr;
         uint32 CurrentKeyNameLen;
 
+        Parser() : Arena(&Strings), DefaultSection(&Values, &Strings)
+        {
+            ClearContent();
+        }
+        Parser(StringArena* arena) : Arena(arena), DefaultSection(&Values, arena)
+        {
+            ClearContent();
+        }
+
         inline void SkipSpaces();
         inline void SkipArrayDelimiters();
         inline void SkipNewLine();
@@ -212,7 +537,13 @@ namespace Ini
         bool ParseState_ExpectingValue();
         bool ParseState_ExpectingArray();
 
+        bool ParseChunk(BuffPtr chunkStart, BuffPtr chunkStop, BuffPtr bufferEnd);
+        bool ParseChunksInParallel(const vector<BuffPtr>& chunks, bool& chunksAreAligned);
+        void MergeChunk(Parser& chunk);
         bool Parse(BuffPtr bufferStart, BuffPtr bufferEnd);
+        BuffPtr SetContent(const uint8* buffer, size_t size);
+        void DetachFromMappedContent();
+        void ClearContent();
         void Clear();
     };
 }; // namespace Ini
@@ -234,7 +565,22 @@ uint64 __compute_hash__(string_view text)
 {
     return __compute_hash__((BuffPtr) text.data(), ((BuffPtr) text.data()) + text.length());
 }
-void AddSectionValueToString(std::string& res, std::string value)
+int32 CompareNames(string_view name1, string_view name2)
+{
+    // case insensitive (same order as String::Compare(..., true))
+    const auto sz = std::min<>(name1.size(), name2.size());
+    for (size_t idx = 0; idx < sz; idx++)
+    {
+        const auto c1 = Ini_LoweCaseTable[(uint8) name1[idx]];
+        const auto c2 = Ini_LoweCaseTable[(uint8) name2[idx]];
+        if (c1 != c2)
+            return c1 < c2 ? -1 : 1;
+    }
+    if (name1.size() == name2.size())
+        return 0;
+    return name1.size() < name2.size() ? -1 : 1;
+}
+void AddSectionValueToString(std::string& res, string_view value)
 {
     // quick_check
     auto spaces        = 0;
@@ -283,7 +629,7 @@ void AddSectionValueToString(std::string& res, std::string value)
 }
 void AddValueToString(std::string& res,AppCUI::Ini::Value& value)
 {
-    res += value.KeyName;
+    res += (string_view) value.KeyName;
     res += " = ";
     if (value.KeyValues.size() > 0)
     {
@@ -306,25 +652,25 @@ void AddValueToString(std::string& res,AppCUI::Ini::Value& value)
 void AddSectionToString(std::string& res, Ini::Section& sect, bool sorted)
 {
     res += "\n";
-    if (sect.Name.Len() > 0)
+    if (sect.Name.Length > 0)
     {
         res += "[";
-        res += sect.Name;
+        res += (string_view) sect.Name;
         res += "]";
         res += "\n";
     }
     // add values
     if (sorted)
     {
-        PointerArrayStorage<AppCUI::Ini::Value> entries(sect.Keys.size());
+        PointerArrayStorage<AppCUI::Ini::Value> entries(sect.Keys.Size());
         size_t idx = 0;
         for (auto& entry : sect.Keys)
-            entries[idx++] = &entry.second;
+            entries[idx++] = entry.Item;
         struct
         {
             bool operator()(AppCUI::Ini::Value* v1, AppCUI::Ini::Value* v2) const
             {
-                return String::Compare(v1->KeyName.c_str(), v2->KeyName.c_str(), true) < 0;
+                return CompareNames(v1->KeyName, v2->KeyName) < 0;
             }
         } CompareIniValue;
         std::sort(entries.begin(), entries.end(), CompareIniValue);
@@ -339,7 +685,7 @@ void AddSectionToString(std::string& res, Ini::Section& sect, bool sorted)
         // write them as they are (faster)
         for (auto& entry : sect.Keys)
         {
-            AddValueToString(res, entry.second);
+            AddValueToString(res, *entry.Item);
         }
     }
 }
@@ -454,7 +800,8 @@ bool Ini::Parser::ParseState_ExpectingKeyOrSection()
 {
     BuffPtr nameStart, nameEnd;
 
-    while (current < end)
+    // a chunk ends where the next one starts (with a section)
+    while (current < chunkEnd)
     {
         switch (Ini_Char_Type[*current])
         {
@@ -563,8 +910,8 @@ bool Ini::Parser::ParseState_ExpectingArray()
     // sanity check
     PARSER_CHECK(current < end, false, "Premature end of INI file: expecting a value after '[' character !");
     // all good --> create the value
-    auto& value       = CurrentSection->Keys[this->CurrentKeyHash];
-    value.KeyName     = string_view((const char*) CurrentKeyNamePtr, CurrentKeyNameLen);
+    auto& value       = *CurrentSection->GetOrCreateValue(this->CurrentKeyHash);
+    value.KeyName     = Text(CurrentKeyNamePtr, CurrentKeyNamePtr + CurrentKeyNameLen);
     CurrentKeyNamePtr = nullptr;
     CurrentKeyNameLen = 0;
     // value is created and is empy
@@ -605,28 +952,69 @@ bool Ini::Parser::ParseState_ExpectingArray()
     }
     return true;
 }
-void Ini::Parser::Clear()
+void Ini::Parser::ClearContent()
 {
-    this->Sections.clear();
-    this->DefaultSection.Keys.clear();
+    this->Sections.Clear();
+    this->DefaultSection.Clear();
+    this->Values.Clear();
     this->CurrentSection    = &this->DefaultSection;
     this->CurrentKeyHash    = 0;
     this->CurrentKeyNamePtr = nullptr;
     this->CurrentKeyNameLen = 0;
 }
-bool Ini::Parser::Parse(BuffPtr bufferStart, BuffPtr bufferEnd)
+void Ini::Parser::Clear()
 {
-    Clear();
-    // sanity check
-    CHECK(bufferStart, false, "Expecting a valid value for internal 'bufferStart' pointer");
-    CHECK(bufferStart <= bufferEnd, false, "Expecting a valid value for internal 'bufferEnd' pointer");
-    // reset
-    start   = bufferStart;
-    end     = bufferEnd;
-    current = start;
-    state   = Ini::ParseState::ExpectingKeyOrSection;
+    ClearContent();
+    this->Strings.Clear();
+    this->Content.reset();
+    this->MappedContent.Close();
+}
+BuffPtr Ini::Parser::SetContent(const uint8* buffer, size_t size)
+{
+    this->Content.reset(new char[std::max<size_t>(size, 1)]);
+    memcpy(this->Content.get(), buffer, size);
+    return (BuffPtr) this->Content.get();
+}
+void Ini::Parser::DetachFromMappedContent()
+{
+    const auto mapStart = (const char*) MappedContent.GetData();
+    if (!mapStart)
+        return;
+    const auto mapEnd = mapStart + MappedContent.GetSize();
+    SetContent(MappedContent.GetData(), (size_t) MappedContent.GetSize());
+    const auto newStart = this->Content.get();
+    auto rebase         = [mapStart, mapEnd, newStart](Text& text) {
+        // strings from the arena are always null terminated, the ones from the file never are
+        if ((text.Data) && (!text.Terminated) && (text.Data >= mapStart) && (text.Data <= mapEnd))
+            text.Data = newStart + (text.Data - mapStart);
+    };
+    // deleted values are also rebased (an IniValue object might still refer them)
+    for (auto& block : Values.GetBlocks())
+    {
+        for (auto& value : block)
+        {
+            rebase(value.KeyName);
+            rebase(value.KeyValue);
+            for (auto& arrayValue : value.KeyValues)
+                rebase(arrayValue);
+        }
+    }
+    for (auto& entry : Sections)
+        rebase(entry.Item->Name);
+    MappedContent.Close();
+}
+bool Ini::Parser::ParseChunk(BuffPtr chunkStart, BuffPtr chunkStop, BuffPtr bufferEnd)
+{
+    start    = chunkStart;
+    end      = bufferEnd;
+    chunkEnd = chunkStop;
+    current  = start;
+    state    = Ini::ParseState::ExpectingKeyOrSection;
     while (current < end)
     {
+        // the last key or array of a chunk may continue in the next one, but a new key or section can not
+        if ((state == Ini::ParseState::ExpectingKeyOrSection) && (current >= chunkEnd))
+            break;
         switch (state)
         {
         case Ini::ParseState::ExpectingKeyOrSection:
@@ -648,30 +1036,129 @@ bool Ini::Parser::Parse(BuffPtr bufferStart, BuffPtr bufferEnd)
     }
     return true;
 }
+bool Ini::Parser::ParseChunksInParallel(const vector<BuffPtr>& chunks, bool& chunksAreAligned)
+{
+    // chunks[idx] .. chunks[idx+1] is a chunk --> the first one is parsed by this parser, the rest by new ones
+    const auto count = chunks.size() - 1;
+    const auto bufferEnd = chunks[count];
+    vector<unique_ptr<Parser>> parsers;
+    unique_ptr<bool[]> results(new bool[count]);
+    parsers.reserve(count - 1);
+    for (size_t idx = 1; idx < count; idx++)
+        parsers.push_back(std::make_unique<Parser>(this->Arena));
+    Internal::RunInParallel(
+          (uint32) count,
+          [this, &parsers, &chunks, &results, bufferEnd](uint32 idx)
+          {
+              auto p       = idx == 0 ? this : parsers[idx - 1].get();
+              results[idx] = p->ParseChunk(chunks[idx], chunks[idx + 1], bufferEnd);
+          });
+
+    // a chunk is valid only if the previous one stopped exactly where it starts (a chunk can start inside a
+    // multi-line string or array of the previous one)
+    chunksAreAligned = true;
+    CHECK(results[0], false, "");
+    auto stop = this->current;
+    for (size_t idx = 1; idx < count; idx++)
+    {
+        if (stop != chunks[idx])
+        {
+            chunksAreAligned = false;
+            return false;
+        }
+        CHECK(results[idx], false, "");
+        stop = parsers[idx - 1]->current;
+    }
+    for (auto& p : parsers)
+        MergeChunk(*p);
+    return true;
+}
+void Ini::Parser::MergeChunk(Parser& chunk)
+{
+    // a chunk starts with a section --> its default section is always empty
+    for (auto& entry : chunk.Sections)
+    {
+        auto sect = Sections.Find(entry.Hash);
+        if (!sect)
+        {
+            entry.Item->Storage = &this->Values;
+            Sections.Add(entry.Hash, std::move(entry.Item));
+            continue;
+        }
+        // same section in multiple chunks --> the result must be the same as for a sequential parse
+        for (auto& key : entry.Item->Keys)
+        {
+            auto source = key.Item;
+            auto value  = (*sect)->GetOrCreateValue(key.Hash);
+            value->KeyName = source->KeyName;
+            if (source->KeyValue.IsSet())
+                value->KeyValue = source->KeyValue;
+            value->KeyValues.insert(value->KeyValues.end(), source->KeyValues.begin(), source->KeyValues.end());
+        }
+    }
+    Values.Adopt(chunk.Values);
+}
+bool Ini::Parser::Parse(BuffPtr bufferStart, BuffPtr bufferEnd)
+{
+    // below this size, handing the chunks to other threads costs more than the parsing itself
+    constexpr size_t MIN_BYTES_PER_CHUNK = 0x100000;
+
+    ClearContent();
+    // sanity check
+    CHECK(bufferStart, false, "Expecting a valid value for internal 'bufferStart' pointer");
+    CHECK(bufferStart <= bufferEnd, false, "Expecting a valid value for internal 'bufferEnd' pointer");
+
+    // large buffers are split in chunks that start with a section ('[' at the beginning of a line)
+    const auto size = (size_t) (bufferEnd - bufferStart);
+    const auto threads = std::min<size_t>((size_t) std::thread::hardware_concurrency(), size / MIN_BYTES_PER_CHUNK);
+    vector<BuffPtr> chunks;
+    chunks.push_back(bufferStart);
+    for (size_t idx = 1; idx < threads; idx++)
+    {
+        auto p = std::max<>(bufferStart + size * idx / threads, chunks.back());
+        while ((p = (BuffPtr) memchr(p, '\n', (size_t) (bufferEnd - p))) != nullptr)
+        {
+            p++;
+            if ((p < bufferEnd) && ((*p) == '['))
+                break;
+        }
+        if ((!p) || (p >= bufferEnd))
+            break;
+        chunks.push_back(p);
+    }
+    chunks.push_back(bufferEnd);
+    if (chunks.size() > 2)
+    {
+        bool chunksAreAligned;
+        if (ParseChunksInParallel(chunks, chunksAreAligned))
+            return true;
+        if (chunksAreAligned)
+            return false; // parse error
+        ClearContent();
+    }
+    return ParseChunk(bufferStart, bufferEnd, bufferEnd);
+}
 bool Ini::Parser::AddSection(BuffPtr nameStart, BuffPtr nameEnd)
 {
     uint64 hash = __compute_hash__(nameStart, nameEnd);
-    auto& sect  = Sections[hash];
-    if (sect.get() == nullptr)
+    auto sect   = Sections.Find(hash);
+    if (sect)
     {
-        sect.reset(new Section());
+        CurrentSection = sect->get();
+        return true;
     }
-    CurrentSection = sect.get();
+    Sections.Add(hash, std::make_unique<Section>(&this->Values, this->Arena));
+    CurrentSection = Sections.Find(hash)->get();
     CHECK(CurrentSection, false, "Fail to allocate a section");
-    if (CurrentSection->Name.Len() == 0)
-    {
-        CHECK(CurrentSection->Name.Set((const char*) nameStart, (uint32) (nameEnd - nameStart)),
-              false,
-              "Fail to allocate section name");
-    }
+    CurrentSection->Name = Text(nameStart, nameEnd);
     return true;
 }
 bool Ini::Parser::AddValue(BuffPtr valueStart, BuffPtr valueEnd)
 {
     CHECK(valueStart <= valueEnd, false, "Invalid buffer pointers !");
-    auto& value       = CurrentSection->Keys[this->CurrentKeyHash];
-    value.KeyValue    = string_view((const char*) valueStart, (uint32) (valueEnd - valueStart));
-    value.KeyName     = string_view((const char*) CurrentKeyNamePtr, CurrentKeyNameLen);
+    auto value        = CurrentSection->GetOrCreateValue(this->CurrentKeyHash);
+    value->KeyValue   = Text(valueStart, valueEnd);
+    value->KeyName    = Text(CurrentKeyNamePtr, CurrentKeyNamePtr + CurrentKeyNameLen);
     CurrentKeyNamePtr = nullptr;
     CurrentKeyNameLen = 0;
     return true;
@@ -679,11 +1166,11 @@ bool Ini::Parser::AddValue(BuffPtr valueStart, BuffPtr valueEnd)
 bool Ini::Parser::AddArrayValue(Ini::Value& value, BuffPtr valueStart, BuffPtr valueEnd)
 {
     CHECK(valueStart <= valueEnd, false, "Invalid buffer pointers !");
-    value.KeyValues.push_back(std::string(string_view((const char*) valueStart, (uint32) (valueEnd - valueStart))));
+    value.KeyValues.push_back(Text(valueStart, valueEnd));
     return true;
 }
 //============================================================================= INI Section iterator ===
-using IniSectionIterator = std::unordered_map<uint64, IniValue>::iterator;
+using IniSectionIterator = Ini::HashTable<Ini::Value*>::Iterator;
 IniSection::Iterator::Iterator(void* data)
 {
     static_assert(
@@ -700,7 +1187,7 @@ IniSection::Iterator::~Iterator()
 }
       IniSection::Iterator& IniSection::Iterator::operator++()
 {
-    (*((IniSectionIterator*) &this->data))++;
+    ++(*((IniSectionIterator*) &this->data));
     return *this;
 }
 bool IniSection::Iterator::operator!=(const Iterator& it)
@@ -709,41 +1196,41 @@ bool IniSection::Iterator::operator!=(const Iterator& it)
 }
 IniValue IniSection::Iterator::operator*()
 {
-    return IniValue(&((*((IniSectionIterator*) &this->data))->second));
+    return IniValue((*((IniSectionIterator*) &this->data))->Item);
 }
 //============================================================================= INI Section ============
 string_view IniSection::GetName() const
 {
     CHECK(this->Data, "", "");
-    return string_view{ ((Ini::Section*) Data)->Name.GetText(), ((Ini::Section*) Data)->Name.Len() };
+    return ((Ini::Section*) Data)->Name;
 }
 IniValue IniSection::GetValue(string_view keyName)
 {
     CHECK(Data, IniValue(), "Section key does not exists (unable to get key-value datat!)");
     Ini::Section* entry = ((Ini::Section*) Data);
-    auto value          = entry->Keys.find(__compute_hash__(keyName));
-    CHECK(value != entry->Keys.cend(), IniValue(), "Unable to find key !");
+    auto value          = entry->Keys.Find(__compute_hash__(keyName));
+    CHECK(value, IniValue(), "Unable to find key !");
     // all good -> value exists
-    return IniValue(&value->second);
+    return IniValue(*value);
 }
 bool IniSection::HasValue(string_view keyName)
 {
     CHECK(Data, false, "Section key does not exists (unable to get key-value datat!)");
     Ini::Section* entry = ((Ini::Section*) Data);
-    auto value          = entry->Keys.find(__compute_hash__(keyName));
-    return value != entry->Keys.cend();
+    return entry->Keys.Contains(__compute_hash__(keyName));
 }
 IniValue IniSection::operator[](string_view keyName)
 {
     CHECK(Data, IniValue(), "Section key does not exists (unable to get key-value datat!)");
     Ini::Section* entry = ((Ini::Section*) Data);
     auto hash           = __compute_hash__(keyName);
-    auto value          = entry->Keys.find(hash);
+    auto value          = entry->Keys.Find(hash);
     // if element already exists --> return it
-    if (value != entry->Keys.cend())
-        return IniValue(&value->second);
-    auto res = entry->Keys.emplace(hash, Ini::Value(keyName));
-    return IniValue(&res.first->second);
+    if (value)
+        return IniValue(*value);
+    auto newValue     = entry->GetOrCreateValue(hash);
+    newValue->KeyName = entry->Arena->Add(keyName);
+    return IniValue(newValue);
 }
 vector<IniValue> IniSection::GetValues() const
 {
@@ -752,10 +1239,10 @@ vector<IniValue> IniSection::GetValues() const
     vector<IniValue> res;
     auto sect = ((Ini::Section*) Data);
 
-    res.reserve(sect->Keys.size());
+    res.reserve(sect->Keys.Size());
     for (auto& v : sect->Keys)
     {
-        res.push_back(IniValue(&v.second));
+        res.push_back(IniValue(v.Item));
     }
 
     return res;
@@ -774,12 +1261,12 @@ IniSection::Iterator IniSection::end()
 void IniSection::Clear()
 {
     if (this->Data)
-        ((Ini::Section*) Data)->Keys.clear();
+        ((Ini::Section*) Data)->Clear();
 }
 bool IniSection::DeleteValue(string_view keyName)
 {
     CHECK(Data, false, "Section key does not exists (unable to get key-value datat!)");
-    ((Ini::Section*) Data)->Keys.erase(__compute_hash__(keyName));
+    ((Ini::Section*) Data)->Keys.Erase(__compute_hash__(keyName));
     return true;
 }
 template <typename T>
@@ -792,7 +1279,7 @@ void UpdateValueForSection(void* sectionData, string_view name, T value, bool do
     if (dontUpdateIfValueExits)
     {
         auto hash = __compute_hash__(name);
-        if (entry->Keys.contains(hash))
+        if (entry->Keys.Contains(hash))
             return;
     }
     IniSection sect(sectionData);
@@ -899,8 +1386,9 @@ optional<bool> IniValue_ToBool(const char* txt, uint32 len)
             return false;
         break;
     case 3:
-        // in fact there are 4 bytes (3 for the text followed by 0)
-        v = (*((const uint32*) txt)) | 0x202020;
+        // values can be views into the parsed buffer (not null terminated) --> only 3 bytes can be read
+        v = (((uint32) (uint8) txt[0]) | (((uint32) (uint8) txt[1]) << 8) | (((uint32) (uint8) txt[2]) << 16)) |
+            0x202020;
         if (v == INI_VALUE_YES)
             return true;
         if (v == INI_VALUE_OFF)
@@ -946,7 +1434,7 @@ optional<int32> IniValue::AsInt32() const
 optional<bool> IniValue::AsBool() const
 {
     VALIDATE_VALUE(std::nullopt);
-    return IniValue_ToBool(value->KeyValue.c_str(), (uint32) value->KeyValue.length());
+    return IniValue_ToBool(value->KeyValue.Data, value->KeyValue.Length);
 }
 optional<Input::Key> IniValue::AsKey() const
 {
@@ -959,7 +1447,7 @@ optional<Input::Key> IniValue::AsKey() const
 optional<const char*> IniValue::AsString() const
 {
     VALIDATE_VALUE(std::nullopt);
-    return value->KeyValue.c_str();
+    return value->GetCString(value->KeyValue);
 }
 optional<string_view> IniValue::AsStringView() const
 {
@@ -1043,7 +1531,7 @@ Input::Key IniValue::ToKey(Input::Key defaultValue) const
 const char* IniValue::ToString(const char* defaultValue) const
 {
     VALIDATE_VALUE(defaultValue);
-    return value->KeyValue.c_str();
+    return value->GetCString(value->KeyValue);
 }
 string_view IniValue::ToStringView(string_view defaultValue) const
 {
@@ -1116,17 +1604,15 @@ IniValueArray IniValue::operator[](int32 index) const
     if ((index < 0) || (index >= (int32)value->KeyValues.size()))
         return IniValueArray();
 
-    return IniValueArray((string_view) value->KeyValues[index]);
+    // IniValueArray::ToString returns a C-string
+    auto& arrayValue = value->KeyValues[index];
+    return IniValueArray(string_view(value->GetCString(arrayValue), arrayValue.Length));
 }
 
 void IniValue::operator=(bool value)
 {
     PREPARE_VALUE;
-    if (value)
-        iniValue->KeyValue = "true";
-    else
-        iniValue->KeyValue = "false";
-    iniValue->KeyValues.clear();
+    iniValue->SetValue(value ? "true" : "false");
 }
 void IniValue::operator=(uint32 value)
 {
@@ -1148,34 +1634,29 @@ void IniValue::operator=(float value)
 {
     PREPARE_VALUE;
     LocalString<64> tmp;
-    iniValue->KeyValue = tmp.Format("%.3f", value);
-    iniValue->KeyValues.clear();
+    iniValue->SetValue(tmp.Format("%.3f", value));
 }
 void IniValue::operator=(double value)
 {
     PREPARE_VALUE;
     LocalString<64> tmp;
-    iniValue->KeyValue = tmp.Format("%.3lf", value);
-    iniValue->KeyValues.clear();
+    iniValue->SetValue(tmp.Format("%.3lf", value));
 }
 void IniValue::operator=(string_view value)
 {
     PREPARE_VALUE;
-    iniValue->KeyValue = value;
-    iniValue->KeyValues.clear();
+    iniValue->SetValue(value);
 }
 void IniValue::operator=(const char* value)
 {
     PREPARE_VALUE;
-    iniValue->KeyValue = value;
-    iniValue->KeyValues.clear();
+    iniValue->SetValue(value);
 }
 void IniValue::operator=(Graphics::Size value)
 {
     PREPARE_VALUE;
     LocalString<64> tmp;
-    iniValue->KeyValue = tmp.Format("%u x %u", value.Width, value.Height);
-    iniValue->KeyValues.clear();
+    iniValue->SetValue(tmp.Format("%u x %u", value.Width, value.Height));
 }
 void IniValue::operator=(Input::Key value)
 {
@@ -1183,35 +1664,36 @@ void IniValue::operator=(Input::Key value)
     LocalString<64> tmp;
     if (!Utils::KeyUtils::ToString(value, tmp))
         return;
-    iniValue->KeyValue = tmp;
-    iniValue->KeyValues.clear();
+    iniValue->SetValue(tmp);
 }
 void IniValue::operator=(const initializer_list<std::string>& values)
 {
     PREPARE_VALUE;
-    iniValue->KeyValue.clear();
-    iniValue->KeyValues = values;
+    iniValue->SetArray();
+    iniValue->KeyValues.reserve(values.size());
+    for (auto& val : values)
+    {
+        iniValue->AddArrayValue(val);
+    }
 }
 void IniValue::operator=(const initializer_list<const char*>& values)
 {
     PREPARE_VALUE;
-    iniValue->KeyValue.clear();
-    iniValue->KeyValues.clear();
+    iniValue->SetArray();
     iniValue->KeyValues.reserve(values.size());
     for (auto val : values)
     {
-        iniValue->KeyValues.push_back(val);
+        iniValue->AddArrayValue(val);
     }
 }
 void IniValue::operator=(const initializer_list<bool>& values)
 {
     PREPARE_VALUE;
-    iniValue->KeyValue.clear();
-    iniValue->KeyValues.clear();
+    iniValue->SetArray();
     iniValue->KeyValues.reserve(values.size());
     for (auto val : values)
     {
-        iniValue->KeyValues.push_back(val ? "true" : "false");
+        iniValue->AddArrayValue(val ? "true" : "false");
     }
 }
 template <typename T>
@@ -1220,13 +1702,12 @@ void IniValueSetVector(void* Data, const initializer_list<T>& values)
     if (!Data)
         return;
     Ini::Value* iniValue = (Ini::Value*) Data;
-    iniValue->KeyValue.clear();
-    iniValue->KeyValues.clear();
+    iniValue->SetArray();
     iniValue->KeyValues.reserve(values.size());
     NumericFormatter n;
     for (auto val : values)
     {
-        iniValue->KeyValues.push_back(std::string(n.ToDec(val)));
+        iniValue->AddArrayValue(n.ToDec(val));
     }
 }
 void IniValue::operator=(const initializer_list<uint32>& values)
@@ -1379,7 +1860,7 @@ double IniValueArray::ToDouble(double defaultValue) const
         return defaultValue;
 }
 //============================================================================= INI object iterator ===
-using IniObjectIterator = std::unordered_map<uint64, unique_ptr<Ini::Section>>::iterator;
+using IniObjectIterator = Ini::HashTable<unique_ptr<Ini::Section>>::Iterator;
 IniObject::Iterator::Iterator(void* data)
 {
     static_assert(
@@ -1396,7 +1877,7 @@ IniObject::Iterator::~Iterator()
 }
 IniObject::Iterator& IniObject::Iterator::operator++()
 {
-    (*((IniObjectIterator*) &this->data))++;
+    ++(*((IniObjectIterator*) &this->data));
     return *this;
 }
 bool IniObject::Iterator::operator!=(const Iterator& it)
@@ -1405,7 +1886,7 @@ bool IniObject::Iterator::operator!=(const Iterator& it)
 }
 IniSection IniObject::Iterator::operator*()
 {
-    return IniSection((*((IniObjectIterator*) &this->data))->second.get());
+    return IniSection((*((IniObjectIterator*) &this->data))->Item.get());
 }
 //============================================================================= INI Object ===
 IniObject::IniObject()
@@ -1431,19 +1912,42 @@ bool IniObject::CreateFromString(string_view text)
 {
     CHECK(text.data(), false, "Expecting a valid (non-null) string !");
     CHECK(Init(), false, "Fail to initialize parser object !");
-    BuffPtr start = (BuffPtr) text.data();
+    WRAPPER->Clear();
+    // names and values are views into a copy of the text
+    BuffPtr start = WRAPPER->SetContent((BuffPtr) text.data(), text.length());
     BuffPtr end   = start + text.length();
     CHECK(WRAPPER->Parse(start, end), false, "Fail to parser buffer !");
     return true;
 }
-bool IniObject::CreateFromFile(const std::filesystem::path& fileName)
+bool IniObject::CreateFromFile(const std::filesystem::path& fileName, bool zeroCopy)
 {
-    auto buf = OS::File::ReadContent(fileName);
-    CHECK(buf.IsValid(), false, "Unable to read content of ini file: %s", fileName.string().c_str());
-    return CreateFromString(buf);
+    CHECK(Init(), false, "Fail to initialize parser object !");
+    WRAPPER->Clear();
+    auto& file = WRAPPER->MappedContent;
+    if (!file.OpenRead(fileName))
+    {
+        // empty files can not be mapped
+        auto buf = OS::File::ReadContent(fileName);
+        CHECK(buf.IsValid(), false, "Unable to read content of ini file: %s", fileName.string().c_str());
+        return CreateFromString(buf);
+    }
+    // zero-copy --> names and values are views directly into the mapped file (until the object is saved or cleared)
+    const auto size = (size_t) file.GetSize();
+    BuffPtr start   = file.GetData();
+    if (!zeroCopy)
+    {
+        start = WRAPPER->SetContent(file.GetData(), size);
+        file.Close();
+    }
+    BuffPtr end = start + size;
+    CHECK(WRAPPER->Parse(start, end), false, "Fail to parse ini file: %s", fileName.string().c_str());
+    return true;
 }
 bool IniObject::Save(const std::filesystem::path& fileName)
 {
+    // the file might be the one that is mapped in memory (and it will be overwritten)
+    if (this->Data)
+        WRAPPER->DetachFromMappedContent();
     auto iniContent = this->ToString();
     CHECK(!iniContent.empty(), false, "Fail to create ini content !");
     OS::File f;
@@ -1479,10 +1983,10 @@ bool IniObject::DeleteSection(string_view name)
     // null-strings or empty strings refer to the Default section that always exists
     if ((name.data() == nullptr) || (name.length() == 0))
     {
-        WRAPPER->DefaultSection.Keys.clear();
+        WRAPPER->DefaultSection.Clear();
         return true;
     }
-    WRAPPER->Sections.erase(__compute_hash__(name));
+    WRAPPER->Sections.Erase(__compute_hash__(name));
     return true;
 }
 bool IniObject::HasSection(string_view name) const
@@ -1491,17 +1995,17 @@ bool IniObject::HasSection(string_view name) const
     // null-strings or empty strings refer to the Default section that always exists
     if ((name.data() == nullptr) || (name.length() == 0))
         return true;
-    return WRAPPER->Sections.contains(__compute_hash__(name));
+    return WRAPPER->Sections.Contains(__compute_hash__(name));
 }
 IniSection IniObject::GetSection(string_view name)
 {
     VALIDATE_INITED(IniSection());
     if ((name.data() == nullptr) || (name.length() == 0))
         return IniSection(&(WRAPPER->DefaultSection));
-    auto result = WRAPPER->Sections.find(__compute_hash__(name));
-    if (result == WRAPPER->Sections.cend())
+    auto result = WRAPPER->Sections.Find(__compute_hash__(name));
+    if (!result)
         return IniSection();
-    return IniSection(result->second.get());
+    return IniSection(result->get());
 }
 IniSection IniObject::CreateSection(string_view name, bool emptyContent)
 {
@@ -1513,29 +2017,29 @@ IniSection IniObject::CreateSection(string_view name, bool emptyContent)
     if ((name.data() == nullptr) || (name.length() == 0))
     {
         if (emptyContent)
-            WRAPPER->DefaultSection.Keys.clear();
+            WRAPPER->DefaultSection.Clear();
         return IniSection(&(WRAPPER->DefaultSection));
     }
     // check if the section exists
     auto hash   = __compute_hash__(name);
-    auto result = WRAPPER->Sections.find(hash);
-    if (result != WRAPPER->Sections.cend())
+    auto result = WRAPPER->Sections.Find(hash);
+    if (result)
     {
         if (emptyContent)
-            result->second->Keys.clear();
-        return IniSection(result->second.get());
+            (*result)->Clear();
+        return IniSection(result->get());
     }
     // create a new section
-    auto res = WRAPPER->Sections.emplace(hash, std::make_unique<Ini::Section>(name));
-    return IniSection(res.first->second.get());
+    WRAPPER->Sections.Add(hash, std::make_unique<Ini::Section>(&WRAPPER->Values, WRAPPER->Arena, name));
+    return IniSection(WRAPPER->Sections.Find(hash)->get());
 }
 vector<IniSection> IniObject::GetSections() const
 {
     VALIDATE_INITED(vector<IniSection>());
     vector<IniSection> res;
-    res.reserve(WRAPPER->Sections.size());
+    res.reserve(WRAPPER->Sections.Size());
     for (auto& s : WRAPPER->Sections)
-        res.push_back(IniSection(s.second.get()));
+        res.push_back(IniSection(s.Item.get()));
     return res;
 }
 IniObject::Iterator IniObject::begin()
@@ -1562,25 +2066,25 @@ IniValue IniObject::GetValue(string_view valuePath)
     if (p >= end)
     {
         // no section was provided --> using the default one
-        auto value = WRAPPER->DefaultSection.Keys.find(__compute_hash__(start, end));
-        CHECK(value != WRAPPER->DefaultSection.Keys.cend(), IniValue(), "Unable to find key for default section!");
+        auto value = WRAPPER->DefaultSection.Keys.Find(__compute_hash__(start, end));
+        CHECK(value, IniValue(), "Unable to find key for default section!");
         // all good -> value exists
-        return IniValue(&value->second);
+        return IniValue(*value);
     }
     else
     {
         // we have both a section and a value name
-        auto result = WRAPPER->Sections.find(__compute_hash__(start, p));
-        if (result == WRAPPER->Sections.cend())
+        auto result = WRAPPER->Sections.Find(__compute_hash__(start, p));
+        if (!result)
             return IniValue();
-        Ini::Section* sect = result->second.get();
+        Ini::Section* sect = result->get();
         CHECK(sect, IniValue(), "Invalid section (null)");
         p++;
         CHECK(p < end, IniValue(), "Missing value from path !");
-        auto value = sect->Keys.find(__compute_hash__(p, end));
-        CHECK(value != sect->Keys.cend(), IniValue(), "Unable to find key for section: %s", sect->Name.GetText());
+        auto value = sect->Keys.Find(__compute_hash__(p, end));
+        CHECK(value, IniValue(), "Unable to find key for section: %.*s", sect->Name.Length, sect->Name.Data);
         // all good -> value exists
-        return IniValue(&value->second);
+        return IniValue(*value);
     }
 }
 bool IniObject::DeleteValue(string_view valuePath)
@@ -1597,27 +2101,27 @@ bool IniObject::DeleteValue(string_view valuePath)
     if (p >= end)
     {
         // no section was provided --> using the default one
-        WRAPPER->DefaultSection.Keys.erase(__compute_hash__(start, end));
+        WRAPPER->DefaultSection.Keys.Erase(__compute_hash__(start, end));
         return true;
     }
     else
     {
         // we have both a section and a value name
-        auto result = WRAPPER->Sections.find(__compute_hash__(start, p));
-        if (result == WRAPPER->Sections.cend())
+        auto result = WRAPPER->Sections.Find(__compute_hash__(start, p));
+        if (!result)
             return false;
-        Ini::Section* sect = result->second.get();
+        Ini::Section* sect = result->get();
         CHECK(sect, false, "Invalid section (null)");
         p++;
         CHECK(p < end, false, "Missing value from path !");
-        sect->Keys.erase(__compute_hash__(p, end));
+        sect->Keys.Erase(__compute_hash__(p, end));
         return true;
     }
 }
 uint32 IniObject::GetSectionsCount()
 {
     VALIDATE_INITED(0);
-    return (uint32) WRAPPER->Sections.size();
+    return WRAPPER->Sections.Size();
 }
 
 string_view IniObject::ToString(bool sorted)
@@ -1632,15 +2136,15 @@ string_view IniObject::ToString(bool sorted)
     // add rest of the sections
     if (sorted)
     {
-        PointerArrayStorage<AppCUI::Ini::Section> entries(WRAPPER->Sections.size());
+        PointerArrayStorage<AppCUI::Ini::Section> entries(WRAPPER->Sections.Size());
         size_t idx = 0;
         for (auto& entry : WRAPPER->Sections)
-            entries[idx++] = entry.second.get();
+            entries[idx++] = entry.Item.get();
         struct
         {
             bool operator()(AppCUI::Ini::Section* s1, AppCUI::Ini::Section* s2) const
             {
-                return s1->Name.CompareWith(s2->Name.GetText(),true) < 0;
+                return CompareNames(s1->Name, s2->Name) < 0;
             }
         } CompareIniSections;
         std::sort(entries.begin(), entries.end(), CompareIniSections);
@@ -1654,7 +2158,7 @@ string_view IniObject::ToString(bool sorted)
         // faster -> no sort
         for (auto& entry : WRAPPER->Sections)
         {
-            AddSectionToString(WRAPPER->toStringBuffer, *entry.second, sorted);
+            AddSectionToString(WRAPPER->toStringBuffer, *entry.Item, sorted);
         }
     }
     // return result
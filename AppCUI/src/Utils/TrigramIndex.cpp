@@ -0,0 +1,100 @@
+#include "Internal.hpp"
+
+namespace AppCUI::Utils
+{
+using namespace Graphics;
+
+// same case folding as CharacterBuffer::Find (only ASCII letters are case insensitive)
+static inline uint64 TrigramCode(char16 ch)
+{
+    if ((ch >= 'A') && (ch <= 'Z'))
+        ch |= 0x20;
+    return ch;
+}
+template <typename Callback>
+static void ForEachTrigram(const Character* p, const Character* end, Callback callback)
+{
+    if (end - p < 3)
+        return;
+    uint64 key = (TrigramCode(p[0].Code) << 16) | TrigramCode(p[1].Code);
+    for (p += 2; p < end; p++)
+    {
+        key = ((key << 16) | TrigramCode(p->Code)) & 0xFFFFFFFFFFFFULL;
+        callback(key);
+    }
+}
+
+void TrigramIndex::Clear()
+{
+    items.clear();
+}
+void TrigramIndex::Add(uint32 item, const CharacterBuffer& text)
+{
+    ForEachTrigram(
+          text.GetBuffer(),
+          text.GetBuffer() + text.Len(),
+          [&](uint64 key)
+          {
+              auto& list = items[key];
+              // items are usually added in order --> the list stays sorted without a search
+              if ((list.empty()) || (list.back() < item))
+              {
+                  list.push_back(item);
+                  return;
+              }
+              auto it = std::lower_bound(list.begin(), list.end(), item);
+              if (*it != item)
+                  list.insert(it, item);
+          });
+}
+void TrigramIndex::Remove(uint32 item, const CharacterBuffer& text)
+{
+    ForEachTrigram(
+          text.GetBuffer(),
+          text.GetBuffer() + text.Len(),
+          [&](uint64 key)
+          {
+              auto entry = items.find(key);
+              if (entry == items.end())
+                  return;
+              auto& list = entry->second;
+              auto it    = std::lower_bound(list.begin(), list.end(), item);
+              if ((it != list.end()) && (*it == item))
+                  list.erase(it);
+              if (list.empty())
+                  items.erase(entry);
+          });
+}
+bool TrigramIndex::GetCandidates(u16string_view text, vector<uint32>& result) const
+{
+    result.clear();
+    if (text.size() < 3)
+        return false;
+    vector<const vector<uint32>*> lists;
+    uint64 key = (TrigramCode(text[0]) << 16) | TrigramCode(text[1]);
+    for (size_t idx = 2; idx < text.size(); idx++)
+    {
+        key        = ((key << 16) | TrigramCode(text[idx])) & 0xFFFFFFFFFFFFULL;
+        auto entry = items.find(key);
+        if (entry == items.end())
+            return true; // no item contains this trigram
+        lists.push_back(&entry->second);
+    }
+    // the shortest list is intersected with the others (each one only once)
+    std::sort(lists.begin(), lists.end());
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+    std::sort(lists.begin(), lists.end(), [](auto a, auto b) { return a->size() < b->size(); });
+    result = *lists[0];
+    for (size_t idx = 1; (idx < lists.size()) && (!result.empty()); idx++)
+    {
+        const auto& list = *lists[idx];
+        result.erase(
+              std::remove_if(
+                    result.begin(),
+                    result.end(),
+                    [&list](uint32 item) { return !std::binary_search(list.begin(), list.end(), item); }),
+              result.end());
+    }
+    return true;
+}
+} // namespace AppCUI::Utils
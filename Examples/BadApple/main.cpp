@@ -21,6 +21,7 @@ class VideoScreen : public AppCUI::Controls::UserControl
   public:
     VideoScreen(std::string_view layout) : UserControl(layout), painitng(false), currentFrame(0)
     {
+        EnableFrameUpdates();
     }
 
     void Paint(Graphics::Renderer& renderer) override
@@ -56,6 +56,7 @@ class FramesExample : public Window
     FramesExample() : Window("Test", "d:c,w:40,h:10", WindowFlags::None), counter(0)
     {
         ball = this->CreateChildControl<Ball>();
+        EnableFrameUpdates();
     }
     bool OnFrameUpdate() override
     {
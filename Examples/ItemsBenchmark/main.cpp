@@ -0,0 +1,154 @@
+#include "AppCUI.hpp"
+
+#include <array>
+#include <chrono>
+
+using namespace AppCUI;
+using namespace AppCUI::Application;
+using namespace AppCUI::Controls;
+using namespace AppCUI::Utils;
+
+constexpr uint32 LISTVIEW_ROWS = 200000;
+constexpr uint32 TREEVIEW_ROWS = 200000;
+constexpr uint32 COMBOBOX_ROWS = 60000; // a combobox can have at most 0xFFFF items
+
+class ItemsBenchmark : public Window
+{
+    Reference<ListView> results;
+    vector<std::string> names, sizes, dates;
+
+    void BuildRows(uint32 count)
+    {
+        names.resize(count);
+        sizes.resize(count);
+        dates.resize(count);
+        for (uint32 tr = 0; tr < count; tr++)
+        {
+            names[tr] = "file_" + std::to_string(tr) + ".txt";
+            sizes[tr] = std::to_string((tr * 7919ULL) % 1000000ULL);
+            dates[tr] = "2024-01-" + std::to_string(tr % 28 + 1);
+        }
+    }
+    template <typename T>
+    void Measure(string_view control, string_view method, T&& addRows)
+    {
+        const auto start   = std::chrono::high_resolution_clock::now();
+        const auto added   = addRows();
+        const auto end     = std::chrono::high_resolution_clock::now();
+        const auto seconds = std::chrono::duration<double>(end - start).count();
+
+        LocalString<32> rows, time, speed;
+        rows.Format("%u", added);
+        time.Format("%.1f ms", seconds * 1000.0);
+        speed.Format("%u", static_cast<uint32>(added / seconds));
+        results->AddItem({ control, method, rows.GetText(), time.GetText(), speed.GetText() });
+    }
+
+    void MeasureListView()
+    {
+        BuildRows(LISTVIEW_ROWS);
+        Measure("ListView",
+                "AddItem (per row)",
+                [&]()
+                {
+                    auto lv = Factory::ListView::Create(
+                          "x:0,y:0,w:60,h:20", { "n:Name,w:20", "n:Size,w:10", "n:Date,w:12" });
+                    for (uint32 tr = 0; tr < LISTVIEW_ROWS; tr++)
+                        lv->AddItem({ names[tr], sizes[tr], dates[tr] });
+                    return lv->GetItemsCount();
+                });
+        Measure("ListView",
+                "AddItems (generator)",
+                [&]()
+                {
+                    auto lv = Factory::ListView::Create(
+                          "x:0,y:0,w:60,h:20", { "n:Name,w:20", "n:Size,w:10", "n:Date,w:12" });
+                    lv->AddItems(
+                          LISTVIEW_ROWS,
+                          [&](uint32 index, vector<string_view>& texts)
+                          {
+                              texts.emplace_back(names[index]);
+                              texts.emplace_back(sizes[index]);
+                              texts.emplace_back(dates[index]);
+                              return true;
+                          });
+                    return lv->GetItemsCount();
+                });
+    }
+    void MeasureTreeView()
+    {
+        BuildRows(TREEVIEW_ROWS);
+        Measure("TreeView",
+                "AddItem (per row)",
+                [&]()
+                {
+                    auto tv = Factory::TreeView::Create("x:0,y:0,w:60,h:20", { "n:Name,w:20" });
+                    for (uint32 tr = 0; tr < TREEVIEW_ROWS; tr++)
+                        tv->AddItem(names[tr]);
+                    return tv->GetItemsCount();
+                });
+        Measure("TreeView",
+                "AddItems (range)",
+                [&]()
+                {
+                    vector<std::array<string_view, 1>> rows(TREEVIEW_ROWS);
+                    for (uint32 tr = 0; tr < TREEVIEW_ROWS; tr++)
+                        rows[tr][0] = names[tr];
+                    auto tv = Factory::TreeView::Create("x:0,y:0,w:60,h:20", { "n:Name,w:20" });
+                    tv->AddItems(rows);
+                    return tv->GetItemsCount();
+                });
+    }
+    void MeasureComboBox()
+    {
+        BuildRows(COMBOBOX_ROWS);
+        Measure("ComboBox",
+                "AddItem (per row)",
+                [&]()
+                {
+                    auto cb = Factory::ComboBox::Create("x:0,y:0,w:60");
+                    for (uint32 tr = 0; tr < COMBOBOX_ROWS; tr++)
+                        cb->AddItem(names[tr]);
+                    return cb->GetItemsCount();
+                });
+        Measure("ComboBox",
+                "AddItems (range)",
+                [&]()
+                {
+                    auto cb = Factory::ComboBox::Create("x:0,y:0,w:60");
+                    cb->AddItems(names);
+                    return cb->GetItemsCount();
+                });
+    }
+
+  public:
+    ItemsBenchmark() : Window("Items benchmark", "d:c,w:90,h:14", WindowFlags::None)
+    {
+        results = Factory::ListView::Create(
+              this,
+              "l:0,t:0,r:0,b:0",
+              { "n:Control,w:12", "n:Method,w:24", "n:Rows,a:r,w:10", "n:Time,a:r,w:14", "n:Rows/sec,a:r,w:14" },
+              ListViewFlags::None);
+        MeasureListView();
+        MeasureTreeView();
+        MeasureComboBox();
+    }
+    bool OnEvent(Reference<Control>, Event eventType, int) override
+    {
+        if (eventType == Event::WindowClose)
+        {
+            Application::Close();
+            return true;
+        }
+        return false;
+    }
+};
+
+int main()
+{
+    if (!Application::Init())
+        return 1;
+    Application::AddWindow(std::make_unique<ItemsBenchmark>());
+    Application::Run();
+    return 0;
+}
@@ -83,26 +83,25 @@ class MyWin : public AppCUI::Controls::Window
 
     void Compute_prime()
     {
-        Utils::LocalString<128> tmp;
-        uint64 value = 1;
-        uint64 count = 0;
-
-        // in this case we don't know what is the range (so we will not provide one)
-        ProgressStatus::Init("Compute", 0, GetFlags());
-
-        while (count < 10000)
+        // the search runs on a worker thread - the progress panel is refreshed by the UI thread
+        auto search = [this](ProgressStatus::Task& task)
         {
-            if (IsPrime(value))
+            Utils::LocalString<128> tmp;
+            uint64 value = 1;
+            uint64 count = 0;
+            while ((count < 10000) && (!task.IsCanceled()))
             {
-                tmp.Format(
-                      "Found %d prime numbers (now testing value: %d)", (uint32) count, (uint32) value);
-                count++;
+                if (IsPrime(value))
+                {
+                    count++;
+                    tmp.Format("Found %d prime numbers (now testing value: %d)", (uint32) count, (uint32) value);
+                    task.Update(count, tmp.GetText());
+                }
+                value++;
             }
-            value++;
-            // if progress status Update method returns true, then 'Escape' has been hit and we stop the search
-            if (ProgressStatus::Update(count, tmp.GetText()))
-                break;
-        }
+        };
+        // in this case we don't know what is the range (so we will not provide one)
+        ProgressStatus::Run("Compute", 0, search, GetFlags());
     }
 
     bool OnEvent(Reference<Control>, Event eventType, int controlID) override
@@ -62,6 +62,7 @@ class MyUserControl : public UserControl, public PropertiesInterface
         flags              = 59;
         name               = u"Dragoș";
         keyToStopAnimation = Input::Key::F1;
+        EnableFrameUpdates();
     }
     bool OnFrameUpdate() override
     {
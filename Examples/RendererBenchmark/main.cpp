@@ -0,0 +1,61 @@
+#include "AppCUI.hpp"
+
+#include <chrono>
+#include <iostream>
+
+using namespace AppCUI;
+using namespace AppCUI::Graphics;
+
+constexpr uint32 SCREEN_WIDTH  = 320;
+constexpr uint32 SCREEN_HEIGHT = 100;
+constexpr uint32 ITERATIONS    = 2000;
+
+template <typename T>
+void Measure(const char* name, T&& operation)
+{
+    operation(); // warm-up
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (uint32 tr = 0; tr < ITERATIONS; tr++)
+        operation();
+    const auto end     = std::chrono::high_resolution_clock::now();
+    const auto seconds = std::chrono::duration<double>(end - start).count();
+    const auto cells   = static_cast<double>(SCREEN_WIDTH) * SCREEN_HEIGHT * ITERATIONS;
+    std::cout << name << " : " << static_cast<uint64>(cells / (seconds * 1000000.0)) << " M cells/sec" << std::endl;
+}
+
+int main()
+{
+    Canvas screen, canvas;
+    if ((!screen.Create(SCREEN_WIDTH, SCREEN_HEIGHT)) || (!canvas.Create(SCREEN_WIDTH, SCREEN_HEIGHT, 'x')))
+    {
+        std::cout << "Fail to create canvas objects !" << std::endl;
+        return 1;
+    }
+    const int r = SCREEN_WIDTH - 1;
+    const int b = SCREEN_HEIGHT - 1;
+
+    Measure("Clear (entire surface)       ", [&]() { screen.Clear(' ', ColorPair{ Color::White, Color::DarkBlue }); });
+    Measure("FillRect (opaque)            ", [&]() {
+        screen.FillRect(1, 0, r, b, '.', ColorPair{ Color::Red, Color::Black });
+    });
+    Measure("FillRect (blended)           ", [&]() {
+        screen.FillRect(1, 0, r, b, -1, ColorPair{ Color::Yellow, Color::Transparent });
+    });
+    Measure("FillHorizontalLine (opaque)  ", [&]() {
+        for (int y = 0; y <= b; y++)
+            screen.FillHorizontalLine(0, y, r, '-', ColorPair{ Color::White, Color::Black });
+    });
+    Measure("FillHorizontalLine (blended) ", [&]() {
+        for (int y = 0; y <= b; y++)
+            screen.FillHorizontalLine(0, y, r, -1, ColorPair{ Color::Transparent, Color::Blue });
+    });
+    Measure("DrawCanvas (copy)            ", [&]() { screen.DrawCanvas(1, 0, canvas, NoColorPair); });
+    Measure("DrawCanvas (opaque color)    ", [&]() {
+        screen.DrawCanvas(1, 0, canvas, ColorPair{ Color::Aqua, Color::Black });
+    });
+    Measure("DrawCanvas (blended color)   ", [&]() {
+        screen.DrawCanvas(1, 0, canvas, ColorPair{ Color::Aqua, Color::Transparent });
+    });
+    Measure("DarkenScreen                 ", [&]() { screen.DarkenScreen(); });
+    return 0;
+}
@@ -1,117 +1,27 @@
 #include "AppCUI.hpp"
-#include <filesystem>
-#include <fstream>
-#include <iostream>
-#include <istream>
-#include <iterator>
 
 using namespace AppCUI;
 using namespace AppCUI::Application;
 using namespace AppCUI::Controls;
 using namespace AppCUI::Graphics;
-namespace fs = std::filesystem;
 
 constexpr int COMMAND_ID_BTN_OPEN = 1;
-
-class HexViewUserControl : public UserControl
-{
-  public:
-    HexViewUserControl(std::string_view layout) : UserControl(layout)
-    {
-        resetAll();
-    }
-
-    bool Open(const fs::path& filePath)
-    {
-        resetAll();
-        return readAll(filePath);
-    }
-
-    void Paint(Graphics::Renderer& renderer) override
-    {
-        renderer.Clear(' ', ColorPair{ Color::White, Color::Black });
-
-        const uint64 height     = GetHeight();
-        const uint64 width      = GetWidth();
-        const uint64 bufferSize = height * width;
-        const uint64 maxProcess = std::min(bufferSize, fileSize - filePosition);
-
-        for (uint64 i = 0; i < maxProcess; i++)
-        {
-            const int y = static_cast<int>(i / width);
-            const int x = static_cast<int>(i % width);
-            renderer.WriteCharacter(x, y, fileData[filePosition + i], ColorPair{ Color::White, Color::Transparent });
-        }
-    }
-
-    bool OnKeyEvent(AppCUI::Input::Key keyCode, char16 /*AsciiCode*/) override
-    {
-        const uint64 bufferSize = (uint64)GetWidth() * (uint64)GetHeight();
-
-        switch (keyCode)
-        {
-        case Input::Key::PageDown:
-            if (filePosition + bufferSize < fileSize)
-            {
-                filePosition += bufferSize;
-            }
-            return true;
-        case Input::Key::PageUp:
-            if (filePosition < bufferSize)
-            {
-                filePosition = 0;
-            }
-            else
-            {
-                filePosition -= bufferSize;
-            }
-            return true;
-        default:
-            break;
-        }
-        return false;
-    }
-
-  private:
-    void resetAll()
-    {
-        fileData.clear();
-        fileSize     = 0;
-        filePosition = 0;
-    }
-
-    bool readAll(const fs::path& filePath)
-    {
-        CHECK(fs::exists(filePath), false, "File %s doesn't exist", filePath.string().c_str());
-        fileSize = fs::file_size(filePath);
-
-        std::ifstream fileStream(filePath);
-        fileData.reserve(fileSize);
-        std::copy(
-              std::istream_iterator<uint8>(fileStream),
-              std::istream_iterator<uint8>(),
-              std::back_inserter(fileData));
-        fileSize = fileData.size();
-
-        return true;
-    }
-
-  private:
-    std::vector<uint8> fileData;
-    uint64 filePosition;
-    uint64 fileSize;
-};
+constexpr int CONTROL_ID_SEARCH   = 2;
 
 class SimpleHexView : public AppCUI::Controls::Window
 {
   private:
-    Reference<HexViewUserControl> hexView;
+    Reference<HexView> hexView;
+    Reference<TextField> search;
 
   public:
     SimpleHexView() : Window("SimpleHexView", "x:0,y:0,w:100%,h:100%", WindowFlags::None)
     {
-        Factory::Button::Create(this, "Open File ...", "l:2,t:0,r:2,h:1", COMMAND_ID_BTN_OPEN, ButtonFlags::Flat);
-        hexView = this->CreateChildControl<HexViewUserControl>("x:0,y:2,w:100%,h:100%");
+        Factory::Button::Create(this, "Open File ...", "l:2,t:0,w:16,h:1", COMMAND_ID_BTN_OPEN, ButtonFlags::Flat);
+        Factory::Label::Create(this, "Search (Enter, F3/Shift+F3)", "l:20,t:0,w:28,h:1");
+        search = Factory::TextField::Create(this, "", "l:49,t:0,r:2,h:1", TextFieldFlags::ProcessEnter);
+        search->SetControlID(CONTROL_ID_SEARCH);
+        hexView = Factory::HexView::Create(this, "l:0,t:2,r:0,b:0");
     }
 
     bool OnEvent(Reference<Control> /*sender*/, Event eventType, int controlID) override
@@ -127,9 +37,20 @@ class SimpleHexView : public AppCUI::Controls::Window
             auto path = Dialogs::FileDialog::ShowOpenFileWindow("", "", ".");
             if (path.has_value())
             {
-                hexView->Open(path.value());
+                if (!hexView->OpenFile(path.value()))
+                    Dialogs::MessageBox::ShowError("Error", "Fail to open the file !");
                 hexView->SetFocus();
             }
+            return true;
+        }
+        if (eventType == Event::TextFieldValidate && controlID == CONTROL_ID_SEARCH)
+        {
+            // the matches are highlighted while the file is searched
+            const auto text = (std::string) search->GetText();
+            if (!text.empty())
+                hexView->Search(Utils::BufferView(text.data(), text.size()));
+            hexView->SetFocus();
+            return true;
         }
         return false;
     }
@@ -137,7 +58,9 @@ class SimpleHexView : public AppCUI::Controls::Window
 
 int main()
 {
-    if (!Application::Init(InitializationFlags::CommandBar | InitializationFlags::LoadSettingsFile))
+    if (!Application::Init(
+              InitializationFlags::CommandBar | InitializationFlags::LoadSettingsFile |
+              InitializationFlags::EnableFPSMode))
         return -1;
     auto window = std::make_unique<SimpleHexView>();
     Application::AddWindow(std::move(window));
@@ -8,6 +8,7 @@ Game::Game() noexcept
     data->tab = Factory::Tab::Create(this, "d:c", TabFlags::HideTabs | TabFlags::TransparentBackground);
     data->machine->PushState<MainMenuState>(data);
     data->machine->ProcessStackAction();
+    EnableFrameUpdates();
 }
 
 bool Game::OnEvent(Reference<Control> ctrl, Event eventType, int controlID)
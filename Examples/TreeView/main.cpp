@@ -2,7 +2,6 @@
 #include <cstring>
 #include <string>
 #include <charconv>
-#include <list>
 
 #if defined(BUILD_FOR_OSX) || defined(BUILD_FOR_UNIX)
 #    include <sys/stat.h>
@@ -14,7 +13,7 @@ using namespace AppCUI::Dialogs;
 using namespace AppCUI::Graphics;
 using namespace AppCUI::Controls;
 
-class TreeExample : public Window, public Handlers::OnTreeViewItemToggleInterface
+class TreeExample : public Window
 {
     enum class ControlIds : uint32
     {
@@ -27,8 +26,6 @@ class TreeExample : public Window, public Handlers::OnTreeViewItemToggleInterfac
     Reference<Splitter> horizontal;
     Reference<TreeView> tree;
 
-    std::list<std::u16string> pieces;
-
   public:
     TreeExample() : Window("Tree view example", "d:c, w:100%, h:100%", WindowFlags::Sizeable)
     {
@@ -43,14 +40,17 @@ class TreeExample : public Window, public Handlers::OnTreeViewItemToggleInterfac
               this,
               "x:1%, y:20%, w:99%, h:80%",
               { "n:&Path,a:l,w:100", "n:&Last Write Time,a:r,w:25", "n:&Size (bytes),a:r,w:25" },
-              (TreeViewFlags::DynamicallyPopulateNodeChildren | TreeViewFlags::Sortable | TreeViewFlags::Searchable));
+              (TreeViewFlags::Sortable | TreeViewFlags::Searchable));
 
-        tree->Handlers()->OnItemToggle = this;
+        SetRoot(std::filesystem::current_path());
+    }
 
+    void SetRoot(const std::filesystem::path& path)
+    {
         tree->ClearItems();
-        const auto path              = std::filesystem::current_path().u16string();
-        const auto filename          = std::filesystem::current_path().filename().u16string();
-        const auto pathLastWriteTime = GetLastFileWriteText(std::filesystem::current_path());
+
+        const auto filename          = path.filename().u16string();
+        const auto pathLastWriteTime = GetLastFileWriteText(path);
         std::string pathSizeText;
         try
         {
@@ -62,15 +62,18 @@ class TreeExample : public Window, public Handlers::OnTreeViewItemToggleInterfac
             pathSizeText = "0";
         }
 
-        auto root = tree->AddItem(filename, std::filesystem::is_directory(path));
+        auto root = tree->AddItem(filename);
         root.SetValues({ pathLastWriteTime, pathSizeText });
-        root.SetType(TreeViewItem::Type::Emphasized_1);
-
-        auto& cpath = pieces.emplace_back(std::filesystem::current_path().u16string());
-        root.SetData(Reference<std::u16string>(&cpath));
+        if (std::filesystem::is_directory(path))
+        {
+            // the content of the folders is read on a worker thread, only when they are unfolded
+            root.SetType(TreeViewItem::Type::Emphasized_1);
+            root.SetChildrenLoader(LoadDirectory(path));
+            root.Unfold();
+        }
     }
 
-    bool OnEvent(Reference<Control> control, Event eventType, int controlID) override
+    bool OnEvent(Reference<Control> /*control*/, Event eventType, int controlID) override
     {
         switch (eventType)
         {
@@ -86,34 +89,7 @@ class TreeExample : public Window, public Handlers::OnTreeViewItemToggleInterfac
                 if (res.has_value())
                 {
                     currentFolder->SetText(res->u8string());
-                    tree->ClearItems();
-
-                    const auto path              = std::filesystem::path(res->u16string());
-                    const auto filename          = path.filename().u16string();
-                    const auto pathLastWriteTime = GetLastFileWriteText(path);
-
-                    std::string pathSizeText;
-                    try
-                    {
-                        const auto pathSize = std::filesystem::file_size(path);
-                        pathSizeText        = GetTextFromNumber(pathSize);
-                    }
-                    catch (...)
-                    {
-                        pathSizeText = "0";
-                    }
-
-                    auto root = tree->AddItem(filename, std::filesystem::is_directory(path));
-                    root.SetValues({ pathLastWriteTime, pathSizeText });
-                    if (std::filesystem::is_directory(path))
-                    {
-                        root.SetType(TreeViewItem::Type::Emphasized_1);
-                    }
-
-                    auto& localPath = pieces.emplace_back(path.u16string());
-                    root.SetData(Reference<std::u16string>(&localPath));
-
-                    OnTreeViewItemToggle(control.ToObjectRef<TreeView>(), root, std::filesystem::is_directory(path));
+                    SetRoot(std::filesystem::path(res->u16string()));
                 }
 
                 return true;
@@ -124,41 +100,26 @@ class TreeExample : public Window, public Handlers::OnTreeViewItemToggleInterfac
         return false;
     }
 
-    bool OnTreeViewItemToggle(
-          Reference<Controls::TreeView> /*tree*/, TreeViewItem& item, bool /*recursiveCall*/) override
+    static TreeViewChildrenLoader LoadDirectory(std::filesystem::path path)
     {
-        auto data         = item.GetData<Reference<std::u16string>>().ToGenericRef().ToReference<std::u16string>();
-        const auto fsPath = std::filesystem::path(data->c_str());
-        try
+        return [path](TreeViewChildrenReceiver& addChild)
         {
-            const auto rdi = std::filesystem::directory_iterator(fsPath);
-            for (const auto& p : rdi)
+            std::error_code err;
+            auto it = std::filesystem::directory_iterator(path, err);
+            for (; (!err) && (it != std::filesystem::directory_iterator()); it.increment(err))
             {
-                const auto filename          = p.path().filename().u16string();
-                const auto pathLastWriteTime = GetLastFileWriteText(p.path());
-                uint64 pathSize              = p.file_size();
-                const auto pathSizeText      = GetTextFromNumber(pathSize);
-
-                auto child = item.AddChild(filename, p.is_directory());
-                child.SetValues({ pathLastWriteTime, pathSizeText });
-                if (p.is_directory())
-                {
-                    child.SetType(TreeViewItem::Type::Emphasized_1);
-                }
-
-                auto& cpath = pieces.emplace_back(p.path().u16string());
-                child.SetData(Reference<std::u16string>(&cpath));
+                const auto filename          = it->path().filename().u8string();
+                const auto pathLastWriteTime = GetLastFileWriteText(it->path());
+                const auto isDirectory       = it->is_directory(err);
+                const auto pathSizeText      = GetTextFromNumber(isDirectory ? 0 : it->file_size(err));
+
+                const vector<string_view> texts = { { reinterpret_cast<const char*>(filename.data()), filename.size() },
+                                                    pathLastWriteTime,
+                                                    pathSizeText };
+                if (!addChild(texts, isDirectory ? LoadDirectory(it->path()) : nullptr))
+                    return; // the folder was folded
             }
-        }
-        catch (std::exception& e)
-        {
-#ifdef _DEBUG
-            LOG_ERROR("%s", e.what());
-#endif
-            return false;
-        }
-
-        return true;
+        };
     }
 
     static const std::string GetLastFileWriteText(const std::filesystem::path& path)
@@ -22,5 +22,19 @@ int main(void)
     printf("New size: %" PRIu64 "\n", app.GetSize());
     printf("Get poz: %" PRIu64 "\n", app.GetCurrentPos());
     app.Close();
+
+    // an existing file is truncated only if 'overwriteExisting' is set, otherwise Create fails
+    app.Create(fileName, true);
+    app.Write("GDT1", 4, bytesWritten);
+    app.Close();
+    printf("Create (overwrite) existing file: %s\n", app.Create(fileName, true) ? "created" : "failed");
+    printf("Size after overwrite: %" PRIu64 "\n", app.GetSize());
+    app.Write("GDT1", 4, bytesWritten);
+    app.Close();
+    printf("Create (no overwrite) existing file: %s\n", app.Create(fileName, false) ? "created" : "failed");
+    app.Close();
+    app.OpenRead(fileName);
+    printf("Size after failed create: %" PRIu64 "\n", app.GetSize());
+    app.Close();
     return 0;
 }